@@ -0,0 +1,270 @@
+#include "ccodecregistry.h"
+#include "ctextencodingdetector.h"
+#include "ctextparser.h"
+#include "matchfunctions/cmatchfunction_l1.h"
+#include "trigramfrequencytables/ctrigramfrequencytable_english.h"
+#include "trigramfrequencytables/ctrigramfrequencytable_russian.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextCodec>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <math.h>
+
+struct Backend
+{
+	const char* name;
+	CTextEncodingDetector::MatchFunctionFactory factory;
+};
+
+// A copy of a table pruned to its K most frequent trigrams, same as text_analyzer --top-k would produce
+class CTopKTable final : public CTrigramFrequencyTable_Base
+{
+public:
+	// Moving the vector keeps its buffer, so the base class pointer stays valid
+	CTopKTable(std::vector<Entry> entries, QString language) : CTrigramFrequencyTable_Base(entries.data(), entries.size()), _entries(std::move(entries)), _language(std::move(language)) {}
+
+	[[nodiscard]] QString language() const override {return _language;}
+
+private:
+	const std::vector<Entry> _entries;
+	const QString _language;
+};
+
+// k == 0 keeps all the trigrams
+static std::unique_ptr<CTrigramFrequencyTable_Base> topK(const CTrigramFrequencyTable_Base& table, const size_t k)
+{
+	std::vector<CTrigramFrequencyTable_Base::Entry> entries(table.begin(), table.end());
+	if (k > 0 && k < entries.size())
+	{
+		std::nth_element(entries.begin(), entries.begin() + (ptrdiff_t)k, entries.end(), [](const CTrigramFrequencyTable_Base::Entry& l, const CTrigramFrequencyTable_Base::Entry& r) {
+			return l.frequency != r.frequency ? l.frequency > r.frequency : l.trigram < r.trigram;
+		});
+		entries.resize(k);
+
+		float totalFrequency = 0.0f;
+		for (const auto& entry: entries)
+			totalFrequency += entry.frequency;
+
+		for (auto& entry: entries)
+			entry.frequency /= totalFrequency;
+
+		std::sort(entries.begin(), entries.end(), [](const CTrigramFrequencyTable_Base::Entry& l, const CTrigramFrequencyTable_Base::Entry& r) {
+			return l.trigram < r.trigram;
+		});
+	}
+
+	return std::make_unique<CTopKTable>(std::move(entries), table.language());
+}
+
+static void printUsageInstructions()
+{
+	std::cout << "Usage:" << std::endl;
+	std::cout << "match_benchmark [--top-k=K1,K2,...] <path to textfile 1> [path to textfile 2] ... [path to textfile N]" << std::endl;
+	std::cout << std::endl;
+	std::cout << "Compares the match function backends: the time per match() call on the samples of the files parsed with a few common codecs, the agreement of the results, the detect() time per file, and the time to parse a sample with all the single-byte codecs in one pass vs one pass per codec." << std::endl;
+	std::cout << "--top-k: also runs every backend with the built-in tables pruned to their K most frequent trigrams, and reports how often detect() still agrees with the full tables on the encoding and the language." << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+	// 0 stands for the full tables, which are the reference for the agreement
+	std::vector<size_t> tableSizes = {0};
+	int argIndex = 1;
+	if (argIndex < argc && QString(argv[argIndex]).startsWith("--top-k="))
+	{
+		const QStringList values = QString(argv[argIndex]).mid(8).split(",");
+		for (const QString& k: values)
+		{
+			if (k.toInt() > 0)
+				tableSizes.push_back((size_t)k.toInt());
+		}
+
+		++argIndex;
+	}
+
+	if (argIndex >= argc)
+	{
+		printUsageInstructions();
+		return -1;
+	}
+
+	const std::vector<Backend> backends = {
+		{"L1, hash lookup", [](const std::vector<const CTrigramFrequencyTable_Base*>& tables) {return std::make_unique<CMatchFunction_L1>(tables);}},
+	};
+
+	std::vector<QByteArray> inputs;
+	for (int i = argIndex; i < argc; ++i)
+	{
+		QFile file(argv[i]);
+		if (!file.open(QFile::ReadOnly))
+		{
+			std::cout << "Failed to open " << argv[i] << std::endl;
+			continue;
+		}
+
+		inputs.push_back(file.readAll());
+	}
+
+	// The same samples the detector would score
+	std::vector<CTextParser::OccurrenceTable> samples;
+	for (const QByteArray& input: inputs)
+	{
+		const auto sample = CTextSample::fromData(input, CTextSample::Parameters());
+		for (const char* codecName: {"UTF-8", "windows-1252", "windows-1251", "KOI8-R"})
+		{
+			CTextParser parser;
+			if (parser.parse(sample, *QTextCodec::codecForName(codecName)))
+				samples.push_back(parser.parsingResult());
+		}
+	}
+
+	if (samples.empty())
+	{
+		std::cout << "No trigrams found in the input files." << std::endl;
+		return -1;
+	}
+
+	// Parsing the samples with all the single-byte codecs: the one-pass kernel the detector uses without the early exit vs one parse() per codec
+	{
+		const CCodecRegistry& registry = CCodecRegistry::instance();
+		std::vector<const CSingleByteCodecTable*> codecTables;
+		for (const CCodecRegistry::Codec* candidate: registry.candidates())
+		{
+			if (candidate->singleByteTable)
+				codecTables.push_back(candidate->singleByteTable.get());
+		}
+
+		std::vector<CTextSample> inputSamples;
+		for (const QByteArray& input: inputs)
+			inputSamples.push_back(CTextSample::fromData(input, CTextSample::Parameters()));
+
+		std::vector<CTextParser> parsers;
+		for (size_t i = 0; i < codecTables.size(); ++i)
+			parsers.emplace_back(1024);
+
+		constexpr int numRepetitions = 20;
+		size_t checksum = 0;
+		QElapsedTimer timer;
+		timer.start();
+		for (int repetition = 0; repetition < numRepetitions; ++repetition)
+		{
+			for (const auto& sample: inputSamples)
+			{
+				for (auto& parser: parsers)
+					parser.clear();
+
+				const auto parsed = CTextParser::parse(sample, registry.singleByteCodecSet(), parsers);
+				checksum += (size_t)std::count(parsed.begin(), parsed.end(), true);
+			}
+		}
+
+		const double singlePassMicroseconds = (double)timer.nsecsElapsed() / 1000.0 / numRepetitions / (double)inputSamples.size();
+
+		timer.restart();
+		for (int repetition = 0; repetition < numRepetitions; ++repetition)
+		{
+			for (const auto& sample: inputSamples)
+			{
+				for (size_t i = 0; i < codecTables.size(); ++i)
+				{
+					parsers[i].clear();
+					checksum += parsers[i].parse(sample, *codecTables[i]) ? 1 : 0;
+				}
+			}
+		}
+
+		const double perCodecMicroseconds = (double)timer.nsecsElapsed() / 1000.0 / numRepetitions / (double)inputSamples.size();
+
+		std::cout << "Parsing a sample with " << codecTables.size() << " single-byte codecs: " << singlePassMicroseconds << " us in one pass, "
+			<< perCodecMicroseconds << " us with a pass per codec (checksum " << checksum << ")" << std::endl;
+	}
+
+	const CTrigramFrequencyTable_English english;
+	const CTrigramFrequencyTable_Russian russian;
+
+	// The best (encoding, language) for every input with the full tables and the first backend
+	std::vector<std::pair<QString, QString>> referenceResults;
+	for (const size_t k: tableSizes)
+	{
+		std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>> ownedTables;
+		ownedTables.push_back(topK(english, k));
+		ownedTables.push_back(topK(russian, k));
+
+		std::vector<const CTrigramFrequencyTable_Base*> tables;
+		for (const auto& table: ownedTables)
+			tables.push_back(table.get());
+
+		std::cout << (k == 0 ? std::string("Full tables") : "Top " + std::to_string(k) + " trigrams") << ":" << std::endl;
+
+		std::vector<std::vector<float>> referenceMatches;
+		for (const Backend& backend: backends)
+		{
+			const auto matchFunction = backend.factory(tables);
+
+			constexpr int numRepetitions = 200;
+			QElapsedTimer timer;
+			timer.start();
+			float checksum = 0.0f;
+			for (int repetition = 0; repetition < numRepetitions; ++repetition)
+			{
+				for (const auto& sample: samples)
+					checksum += matchFunction->match(sample).front();
+			}
+
+			const double microsecondsPerSample = (double)timer.nsecsElapsed() / 1000.0 / numRepetitions / (double)samples.size();
+
+			// The relative difference from the first backend with the same tables; the summation order may differ, so the results can differ in the last bits
+			float maxRelativeDifference = 0.0f;
+			for (size_t i = 0; i < samples.size(); ++i)
+			{
+				const auto matches = matchFunction->match(samples[i]);
+				if (referenceMatches.size() < samples.size())
+					referenceMatches.push_back(matches);
+
+				for (size_t table = 0; table < matches.size(); ++table)
+					maxRelativeDifference = std::max(maxRelativeDifference, fabsf(matches[table] - referenceMatches[i][table]) / std::max(fabsf(referenceMatches[i][table]), 1e-6f));
+			}
+
+			// The detector takes the ownership of the tables, so it gets its own copies
+			std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>> detectorTables;
+			for (const auto* table: tables)
+				detectorTables.push_back(topK(*table, 0));
+
+			CTextEncodingDetector::Options options;
+			options.preClassify = false; // Otherwise valid UTF-8 inputs are not scored at all
+			options.matchFunction = backend.factory;
+			const CTextEncodingDetector detector(options, std::move(detectorTables));
+			timer.restart();
+			size_t numAgreeingResults = 0;
+			for (size_t i = 0; i < inputs.size(); ++i)
+			{
+				const auto results = detector.detect(inputs[i]);
+				const auto bestResult = results.empty() ? std::pair<QString, QString>() : std::make_pair(results.front().encoding, results.front().language);
+				if (referenceResults.size() < inputs.size())
+					referenceResults.push_back(bestResult);
+
+				if (bestResult == referenceResults[i])
+					++numAgreeingResults;
+
+				if (!results.empty())
+					checksum += results.front().match;
+			}
+
+			const double millisecondsPerFile = (double)timer.nsecsElapsed() / 1e6 / (double)inputs.size();
+			const double agreementPercentage = 100.0 * (double)numAgreeingResults / (double)inputs.size();
+
+			std::cout << "\t" << backend.name << ": " << microsecondsPerSample << " us per match(), " << millisecondsPerFile << " ms per detect(), "
+				<< agreementPercentage << "% detect() agreement with the full tables, max relative difference " << maxRelativeDifference << " (checksum " << checksum << ")" << std::endl;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,242 @@
+#include "ccharactertokenizer.h"
+#include "cdecodingreader.h"
+#include "cencodingpreclassifier.h"
+#include "ctrigramcounttable.h"
+#include "trigramfrequencytables/ctrigramfrequencytable_file.h"
+
+#include <QBuffer>
+#include <QChar>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTextCodec>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Self-checks of the building blocks on fixed inputs. Prints every failed check and returns 1 if there were any.
+
+static int numFailures = 0;
+
+static void check(const bool condition, const std::string& description)
+{
+	if (!condition)
+	{
+		++numFailures;
+		std::cout << "FAILED: " << description << std::endl;
+	}
+}
+
+// The SIMD blocks must produce exactly what QChar does for every UTF-16 unit
+static void testCharacterTokenizer()
+{
+	const QString fragments[] = {
+		QString::fromUtf16(u"Hello, World! The quick brown fox jumps over the lazy dog 0123456789 "),
+		QString::fromUtf16(u"\u0421\u044A\u0435\u0448\u044C \u0436\u0435 \u0435\u0449\u0451 \u044D\u0442\u0438\u0445 \u043C\u044F\u0433\u043A\u0438\u0445 \u0444\u0440\u0430\u043D\u0446\u0443\u0437\u0441\u043A\u0438\u0445 \u0431\u0443\u043B\u043E\u043A, \u0434\u0430 \u0432\u044B\u043F\u0435\u0439 \u0447\u0430\u044E. \u0401\u0416\u0418\u041A \u0400\u040D\u040E\u040F \u0450\u045D\u045E\u045F "),
+		QString::fromUtf16(u"\t\n\r\x0B\x0C  ~`@#$%^&*()_+-=[]{};':\"\\|<>?/ "),
+		QString::fromUtf16(u"\u0395\u03BB\u03BB\u03B7\u03BD\u03B9\u03BA\u03AC \u00C0\u00C9\u00CE\u00D5\u00DC \u00E0\u00E9\u00EE\u00F5\u00FC \u00DF \u01C4 \u01C5 \u0130 \u00A0\u2003\u3000 \u6F22\u5B57 \u0460\u0461 \u0490\u0491 "),
+		QString::fromUtf16(u"\U0001F600 mixed ASCII and \u041A\u0438\u0440\u0438\u043B\u043B\u0438\u0446\u0430 in one block "),
+	};
+
+	// Every length and every starting offset up to a couple of AVX2 blocks, so the tails and the unaligned heads are covered as well as the full blocks
+	QString text;
+	for (const QString& fragment: fragments)
+		text += fragment;
+	text += text;
+
+	for (int offset = 0; offset < 40; ++offset)
+	{
+		for (int length = 0; offset + length <= text.size() && length < 80; ++length)
+		{
+			const auto* source = reinterpret_cast<const char16_t*>(text.utf16()) + offset;
+			std::vector<char16_t> lowercase((size_t)length + 1, u'\xFFFF');
+			std::vector<quint8> classes((size_t)length + 1, 0xFF);
+			CCharacterTokenizer::tokenize(source, (size_t)length, lowercase.data(), classes.data());
+
+			for (int i = 0; i < length; ++i)
+			{
+				const QChar ch(source[i]);
+				const quint8 expectedClass = (ch.isLetter() ? CCharacterTokenizer::Letter : 0) | (ch.isSpace() ? CCharacterTokenizer::Space : 0);
+				const std::string position = " at offset " + std::to_string(offset) + ", length " + std::to_string(length) + ", index " + std::to_string(i);
+				check(lowercase[(size_t)i] == ch.toLower().unicode(), "CCharacterTokenizer: lowercase of U+" + QString::number(ch.unicode(), 16).toStdString() + position);
+				check(classes[(size_t)i] == expectedClass, "CCharacterTokenizer: class of U+" + QString::number(ch.unicode(), 16).toStdString() + position);
+			}
+
+			check(lowercase[(size_t)length] == u'\xFFFF' && classes[(size_t)length] == 0xFF, "CCharacterTokenizer: wrote past the end at offset " + std::to_string(offset) + ", length " + std::to_string(length));
+		}
+	}
+}
+
+static void testUtf8Validation()
+{
+	using Validity = CEncodingPreClassifier::Utf8Validity;
+
+	struct Case
+	{
+		const char* description;
+		std::string data;
+		bool startsMidStream;
+		bool endsMidStream;
+		Validity expected;
+	};
+
+	const Case cases[] = {
+		{"empty", "", false, false, Validity::Ascii},
+		{"ASCII", "Plain 7-bit text", false, false, Validity::Ascii},
+		{"2-byte sequence", "caf\xC3\xA9", false, false, Validity::Valid},
+		{"3-byte sequence", "\xE2\x82\xAC", false, false, Validity::Valid},
+		{"4-byte sequence", "\xF0\x9F\x98\x80", false, false, Validity::Valid},
+		{"U+10FFFF", "\xF4\x8F\xBF\xBF", false, false, Validity::Valid},
+		{"overlong 2-byte form", "\xC0\xAF", false, false, Validity::Invalid},
+		{"overlong 2-byte form with 0xC1", "\xC1\xBF", false, false, Validity::Invalid},
+		{"overlong 3-byte form", "\xE0\x80\xAF", false, false, Validity::Invalid},
+		{"overlong 4-byte form", "\xF0\x80\x80\xAF", false, false, Validity::Invalid},
+		{"surrogate", "\xED\xA0\x80", false, false, Validity::Invalid},
+		{"above U+10FFFF", "\xF4\x90\x80\x80", false, false, Validity::Invalid},
+		{"invalid lead byte", "\xF5\x80\x80\x80", false, false, Validity::Invalid},
+		{"stray continuation byte", "abc\x80", false, false, Validity::Invalid},
+		{"bad continuation byte", "\xE2\x28\xA1", false, false, Validity::Invalid},
+		{"cut-off sequence at the end of the input", "abc\xE2\x82", false, false, Validity::Invalid},
+		{"cut-off sequence at the end of a window", "abc\xE2\x82", false, true, Validity::Ascii},
+		{"cut-off sequence at the end of a window after a multibyte sequence", "\xC3\xA9\xE2\x82", false, true, Validity::Valid},
+		{"cut-off sequence at the start of the input", "\x82\xAC" "abc", false, false, Validity::Invalid},
+		{"cut-off sequence at the start of a window", "\x82\xAC" "abc", true, false, Validity::Ascii},
+		{"more than 3 continuation bytes at the start of a window", "\x80\x80\x80\x80" "abc", true, false, Validity::Invalid},
+	};
+
+	for (const Case& c: cases)
+		check(CEncodingPreClassifier::validateUtf8(c.data.data(), c.data.size(), c.startsMidStream, c.endsMidStream) == c.expected, std::string("validateUtf8: ") + c.description);
+
+	// The ASCII runs are skipped with SIMD: the sequences must be found at every position relative to the vector blocks
+	for (size_t position = 0; position < 70; ++position)
+	{
+		std::string data(100, 'a');
+		data.replace(position, 3, "\xED\xA0\x80");
+		check(CEncodingPreClassifier::validateUtf8(data.data(), data.size(), false, false) == Validity::Invalid, "validateUtf8: surrogate after " + std::to_string(position) + " ASCII bytes");
+
+		data.replace(position, 3, "\xE2\x82\xAC");
+		check(CEncodingPreClassifier::validateUtf8(data.data(), data.size(), false, false) == Validity::Valid, "validateUtf8: 3-byte sequence after " + std::to_string(position) + " ASCII bytes");
+	}
+}
+
+static void testTrigramCountTableMerge()
+{
+	CTrigramCountTable table(4), other(4);
+	table.add(1, 2);
+	table.add(2);
+	other.add(2, 3);
+	other.add(3);
+	// Enough keys to make the target table grow while merging
+	for (CTrigramCountTable::Key key = 100; key < 10100; ++key)
+		other.add(key, key);
+
+	table.merge(other);
+
+	check(table.size() == 3 + 10000, "CTrigramCountTable::merge: size");
+	check(table.count(1) == 2, "CTrigramCountTable::merge: a key only in the target table");
+	check(table.count(2) == 4, "CTrigramCountTable::merge: a key in both tables");
+	check(table.count(3) == 1, "CTrigramCountTable::merge: a key only in the merged table");
+	check(table.count(4) == 0, "CTrigramCountTable::merge: a key in neither table");
+
+	bool allCountsMatch = true;
+	for (CTrigramCountTable::Key key = 100; key < 10100; ++key)
+		allCountsMatch = allCountsMatch && table.count(key) == key;
+	check(allCountsMatch, "CTrigramCountTable::merge: the counts after growing");
+
+	quint64 total = 0;
+	for (const auto& slot: table)
+		total += slot.count;
+	check(total == 2 + 4 + 1 + (100 + 10099) * 10000 / 2, "CTrigramCountTable::merge: iterating the merged table");
+
+	CTrigramCountTable empty;
+	table.merge(empty);
+	check(table.size() == 3 + 10000 && table.count(2) == 4, "CTrigramCountTable::merge: merging an empty table");
+}
+
+static QString decodeWithReader(const QByteArray& data, const qint64 chunkSize)
+{
+	QBuffer buffer;
+	buffer.setData(data);
+	buffer.open(QBuffer::ReadOnly);
+
+	CDecodingReader reader(buffer, *QTextCodec::codecForName("UTF-8"), QByteArray(), chunkSize);
+	QString text;
+	reader.readAll([&text](const QString& chunk) {
+		text += chunk;
+		return true;
+	});
+
+	return text;
+}
+
+static void testDecodingReader()
+{
+	const QString euro = QString::fromUtf8("\xE2\x82\xAC");
+
+	check(decodeWithReader("abc\xE2\x82", 1024) == "abc" + QString(QChar(QChar::ReplacementCharacter)), "CDecodingReader: a sequence cut off by the end of the input becomes U+FFFD");
+	check(decodeWithReader("abc\xE2\x82", 4) == "abc" + QString(QChar(QChar::ReplacementCharacter)), "CDecodingReader: U+FFFD when the cut-off sequence spans two chunks");
+	check(decodeWithReader("\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC", 4) == euro + euro + euro, "CDecodingReader: sequences split between chunks");
+	check(decodeWithReader("abc", 4) == "abc", "CDecodingReader: no U+FFFD after complete input");
+	check(decodeWithReader(QByteArray(), 4).isEmpty(), "CDecodingReader: empty input");
+}
+
+static void testFileTableRoundTrip()
+{
+	QTemporaryDir directory;
+	check(directory.isValid(), "CTrigramFrequencyTable_File: creating a temporary directory");
+	if (!directory.isValid())
+		return;
+
+	const std::vector<CTrigramFrequencyTable_Base::Entry> entries {
+		{CTextParser::packTrigram(U' ', U'a', U'b'), 0.25f},
+		{CTextParser::packTrigram(U'a', U'b', U'c'), 0.5f},
+		{CTextParser::packTrigram(U'\u0431', U'\u0432', U'\u0433'), 0.125f},
+		{CTextParser::packTrigram(U'\u0436', U'\u0451', U' '), 1.0e-6f},
+	};
+
+	// An odd number of UTF-8 bytes in the name so that the entries need the padding
+	const QString language = QString::fromUtf16(u"Espa\u00F1ol");
+	const QString path = directory.filePath("model.bin");
+	check(CTrigramFrequencyTable_File::save(path, language, entries), "CTrigramFrequencyTable_File::save");
+
+	const auto table = CTrigramFrequencyTable_File::load(path);
+	check(table != nullptr, "CTrigramFrequencyTable_File::load");
+	if (table)
+	{
+		check(table->language() == language, "CTrigramFrequencyTable_File: the language name after loading");
+		check(table->size() == entries.size(), "CTrigramFrequencyTable_File: the number of entries after loading");
+
+		bool allEntriesMatch = table->size() == entries.size();
+		for (size_t i = 0; allEntriesMatch && i < entries.size(); ++i)
+			allEntriesMatch = table->begin()[i].trigram == entries[i].trigram && table->begin()[i].frequency == entries[i].frequency;
+		check(allEntriesMatch, "CTrigramFrequencyTable_File: the entries after loading");
+
+		const auto* entry = table->find(entries[2].trigram);
+		check(entry && entry->frequency == entries[2].frequency, "CTrigramFrequencyTable_File: find() on the loaded table");
+		check(table->find(CTextParser::packTrigram(U'x', U'y', U'z')) == nullptr, "CTrigramFrequencyTable_File: find() of a missing trigram");
+	}
+
+	const QString notAModelPath = directory.filePath("not-a-model.bin");
+	QFile notAModel(notAModelPath);
+	notAModel.open(QFile::WriteOnly);
+	notAModel.write(QByteArray(256, 'x'));
+	notAModel.close();
+	check(CTrigramFrequencyTable_File::load(notAModelPath) == nullptr, "CTrigramFrequencyTable_File::load of a file that isn't a model");
+	check(CTrigramFrequencyTable_File::load(directory.filePath("missing.bin")) == nullptr, "CTrigramFrequencyTable_File::load of a missing file");
+}
+
+int main()
+{
+	testCharacterTokenizer();
+	testUtf8Validation();
+	testTrigramCountTableMerge();
+	testDecodingReader();
+	testFileTableRoundTrip();
+
+	if (numFailures == 0)
+		std::cout << "All the checks passed" << std::endl;
+	else
+		std::cout << numFailures << " checks failed" << std::endl;
+
+	return numFailures == 0 ? 0 : 1;
+}
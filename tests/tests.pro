@@ -0,0 +1,40 @@
+DESTDIR  = bin
+TARGET = tests
+TEMPLATE = app
+CONFIG += c++17 console
+
+QT = core
+greaterThan(QT_MAJOR_VERSION, 5) {
+	QT += core5compat
+}
+
+OBJECTS_DIR = build
+MOC_DIR     = build
+UI_DIR      = build
+RCC_DIR     = build
+
+win*{
+	QMAKE_CXXFLAGS += /MP
+	DEFINES += WIN32_LEAN_AND_MEAN NOMINMAX
+	QMAKE_CXXFLAGS_WARN_ON = -W4
+}
+
+linux*|mac*|freebsd{
+	QMAKE_CXXFLAGS += -pedantic-errors
+	QMAKE_CFLAGS += -pedantic-errors
+	QMAKE_CXXFLAGS_WARN_ON = -Wall
+}
+
+win32*:!*msvc2012:*msvc*:!*msvc2010:*msvc* {
+	QMAKE_CXXFLAGS += /FS
+}
+
+INCLUDEPATH += \
+	../text-encoding-detector/src/ \
+	../../qtutils \
+	../../cpputils \
+	../../cpp-template-utils
+
+LIBS += -L../../bin -ltext_encoding_detector
+
+SOURCES += src/main.cpp
@@ -1,86 +1,477 @@
+#include "ccharactertokenizer.h"
+#include "cdecodingreader.h"
 #include "ctextparser.h"
+#include "trigramfrequencytables/ctrigramfrequencytable_file.h"
 
 #include <QTextStream>
 #include <QFile>
 
 #include <assert.h>
 #include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <memory>
+#include <thread>
 #include <utility>
+#include <vector>
+
+#include <stdio.h>
+#ifndef _WIN32
+#include <sys/wait.h>
+#endif
 
 static const QString tableClassHeaderTemplate =
-	"#pragma once\n \
+	"#pragma once\n\
 \n\
 #include \"ctrigramfrequencytable_base.h\"\n\
 \n\
-class CTrigramFrequencyTable_%1 : public CTrigramFrequencyTable_Base\n\
+class CTrigramFrequencyTable_%1 final : public CTrigramFrequencyTable_Base\n\
 {\n\
 public:\n\
 	CTrigramFrequencyTable_%1();\n\
 \n\
-	inline QString language() const override {return \"%1\";}\
-\n\
+	[[nodiscard]] inline QString language() const override {return QStringLiteral(\"%1\");}\n\
 };\n";
 
 static const QString tableClassCppTemplate =
 	"#include \"%1\"\n\
 \n\
-\n\
-struct Trigram {\n\
-\tconst char * trigram;\n\
-\tquint64 count;\n\
+// Sorted by the packed trigram value, see CTextParser::packTrigram()\n\
+static constexpr CTrigramFrequencyTable_Base::Entry trigrams[] = {\n\
+%3\
 };\n\
 \n\
-CTrigramFrequencyTable_%2::CTrigramFrequencyTable_%2()\n\
-{\n\
-\t_table.totalTrigrammsCount = %3ull;\n\
-\tstatic const Trigram trigrams[] = {\n\
-%4\
-\t\t{nullptr, 0},\n\
-\t};\n\
+static_assert(CTrigramFrequencyTable_Base::isSorted(trigrams), \"The trigrams must be sorted for binary search\");\n\
 \n\
-\tfor (quint64 i = 0; trigrams[i].trigram != nullptr; ++i)\n\
-\t\t_table.trigramOccurrenceTable[QString::fromUtf8(trigrams[i].trigram)] = trigrams[i].count;\n\
+CTrigramFrequencyTable_%2::CTrigramFrequencyTable_%2() : CTrigramFrequencyTable_Base(trigrams)\n\
+{\n\
 }\n";
 
-template<typename A, typename B>
-std::multimap<B,A> flip_map(const std::map<A,B> &src)
-{
-	std::multimap<B,A> dst;
-	std::transform(src.begin(), src.end(), std::inserter(dst, dst.begin()), [](const std::pair<A,B> &p){return std::make_pair(p.second, p.first);});
-	return dst;
-}
-
 static void printUsageInstructions()
 {
 	std::cout << "Usage:" << std::endl;
-	std::cout << "text_analyzer <language name> <path to textfile 1> [path to textfile 2] ... [path to textfile N]" << std::endl;
+	std::cout << "text_analyzer [options] <language name> <path to textfile 1> [path to textfile 2] ... [path to textfile N]" << std::endl;
 	std::cout << "Where the text files are encoded in UTF-8." << std::endl;
+	std::cout << "Files compressed with gzip (.gz), zstd (.zst), xz (.xz) or 7-Zip (.7z) are decompressed on the fly, the corresponding tool must be in the PATH." << std::endl;
+	std::cout << std::endl;
+	std::cout << "Options:" << std::endl;
+	std::cout << "--threads=N\tThe number of worker threads, defaults to the number of CPU cores. The output does not depend on it." << std::endl;
+	std::cout << "--full\t\tCount every trigram of the files instead of a sample of each file. The files are streamed, the memory use does not depend on their size; the plain text files larger than 64 MB are split into parts counted in parallel." << std::endl;
+	std::cout << "--binary\tWrite a binary model file instead of the C++ sources." << std::endl;
+	std::cout << "--top-k=K\tKeep the K most frequent trigrams instead of all the trigrams with at least 0.05% occurrence rate." << std::endl;
 	std::cout << std::endl;
 	std::cout << "Output: ctrigramfrequencytable_<Language name>.h and ctrigramfrequencytable_<Language name>.cpp source files in the working directory, containing the declaration and definition of the CTrigramFrequencyTable_<Language name> class." << std::endl;
+	std::cout << "With --binary: ctrigramfrequencytable_<language name>.bin in the working directory, which can be loaded at runtime with CTrigramFrequencyTable_File::load()." << std::endl;
+}
+
+// Large enough for the per-chunk overhead to be negligible, small enough for the decoded text to stay in the L2/L3 cache
+static constexpr qint64 decodingChunkSize = 4 * 1024 * 1024;
+
+// Streams the text through a stateful UTF-8 decoder and counts all of its trigrams; they continue across the chunk boundaries
+static bool parseWholeText(CTextParser& parser, QIODevice& textDevice)
+{
+	CDecodingReader reader(textDevice, *QTextCodec::codecForName("UTF-8"), QByteArray(), decodingChunkSize);
+
+	CTextParser::TrigramState state;
+	bool parsed = false;
+	QString chunk;
+	while (reader.readChunk(chunk))
+		parsed = parser.parse(chunk, state);
+
+	return parsed && !reader.hasReadError();
+}
+
+static bool parseText(CTextParser& parser, QIODevice& textDevice, const bool fullText)
+{
+	return fullText ? parseWholeText(parser, textDevice) : parser.parse(textDevice, "UTF-8");
+}
+
+struct Decompressor
+{
+	const char* fileExtension;
+	const char* program;
+	const char* arguments; // The file path is appended
+};
+
+// The tools write the decompressed data to stdout
+static const std::vector<Decompressor> decompressors = {
+	{".gz", "gzip", "-dc"},
+	{".zst", "zstd", "-dc"},
+	{".xz", "xz", "-dc"},
+	{".7z", "7z", "x -so -bd"},
+};
+
+// The shell command line that runs the decompressor on the file, with its error output discarded
+static QString decompressionCommand(const Decompressor& decompressor, QString filePath)
+{
+#ifdef _WIN32
+	// A Windows path can't contain double quotes
+	const QString quotedPath = "\"" + filePath + "\"";
+	const char* const nullDevice = "NUL";
+#else
+	// Nothing is special inside single quotes except the single quote itself, which is closed, escaped and reopened
+	const QString quotedPath = "'" + filePath.replace("'", "'\\''") + "'";
+	const char* const nullDevice = "/dev/null";
+#endif
+
+	return QString(decompressor.program) + ' ' + decompressor.arguments + ' ' + quotedPath + " 2>" + nullDevice;
+}
+
+// Compressed files are decompressed by an external tool into a pipe, so nothing is unpacked to the disk, and the decompression runs in its own process in parallel with the counting.
+// The pipe is read with the blocking stdio calls: unlike QProcess, they need no event loop and work the same on any thread.
+static bool parseFile(CTextParser& parser, const QString& filePath, const bool fullText)
+{
+	const auto decompressor = std::find_if(decompressors.begin(), decompressors.end(), [&filePath](const Decompressor& d) {
+		return filePath.endsWith(d.fileExtension, Qt::CaseInsensitive);
+	});
+
+	if (decompressor == decompressors.end())
+	{
+		QFile file(filePath);
+		return file.open(QFile::ReadOnly) && parseText(parser, file, fullText);
+	}
+
+	const QString command = decompressionCommand(*decompressor, filePath);
+#ifdef _WIN32
+	FILE* pipe = ::_wpopen(reinterpret_cast<const wchar_t*>(command.utf16()), L"rb");
+#else
+	FILE* pipe = ::popen(command.toLocal8Bit().constData(), "r");
+#endif
+	if (!pipe)
+	{
+		std::cout << (QString("Failed to start ") + decompressor->program + ".\n").toStdString() << std::flush;
+		return false;
+	}
+
+	bool parsed = false;
+	{
+		QFile output;
+		parsed = output.open(pipe, QIODevice::ReadOnly) && parseText(parser, output, fullText);
+	}
+
+	// In the default mode, only a sample of the text is read; closing the pipe early makes the tool fail on its next write and exit
+#ifdef _WIN32
+	const int status = ::_pclose(pipe);
+#else
+	const int status = ::pclose(pipe);
+	if (status != -1 && WIFEXITED(status) && WEXITSTATUS(status) == 127) // The shell could not find the command
+	{
+		std::cout << (QString("Failed to start ") + decompressor->program + ", make sure it's installed and in the PATH.\n").toStdString() << std::flush;
+		return false;
+	}
+#endif
+
+	// A corrupt archive may still produce some text before the tool fails, so the exit status matters when all of the text is counted
+	return parsed && (!fullText || status == 0);
+}
+
+// With --full, the plain files larger than this are split into shards of this size that are counted in parallel
+static constexpr qint64 shardSize = 64 * 1024 * 1024;
+
+static inline bool isUtf8ContinuationByte(const char byte)
+{
+	return (static_cast<uchar>(byte) & 0xC0) == 0x80;
+}
+
+// The first position at or after the given one where a UTF-8 character starts
+static qint64 characterStart(const char* data, const qint64 size, qint64 position)
+{
+	while (position < size && isUtf8ContinuationByte(data[position]))
+		++position;
+
+	return position;
+}
+
+// Decodes the UTF-8 data between two character starts with one stateful decoder, chunk by chunk, and passes the text to onText.
+// A decoder that starts past the beginning of the file keeps U+FEFF as a character instead of skipping it as the byte order mark.
+// A sequence cut off by the end becomes a replacement character, same as in CDecodingReader.
+template <typename OnText>
+static void decodeUtf8(const char* data, const qint64 begin, const qint64 end, OnText&& onText)
+{
+	QTextDecoder decoder(QTextCodec::codecForName("UTF-8"), begin > 0 ? QTextCodec::IgnoreHeader : QTextCodec::DefaultConversion);
+	QString text;
+	for (qint64 chunkBegin = begin; chunkBegin < end; chunkBegin += decodingChunkSize)
+	{
+		decoder.toUnicode(&text, data + chunkBegin, (int)std::min(decodingChunkSize, end - chunkBegin));
+		onText(text);
+	}
+
+	if (decoder.needsMoreData())
+		onText(QString(QChar(QChar::ReplacementCharacter)));
+}
+
+// The lowercase forms of the non-space characters of the text and whether they are letters, the way CTextParser sees them
+static std::vector<std::pair<char16_t, bool>> nonSpaceCharacters(const QString& text)
+{
+	std::vector<char16_t> lowercase((size_t)text.size());
+	std::vector<quint8> classes((size_t)text.size());
+	CCharacterTokenizer::tokenize(reinterpret_cast<const char16_t*>(text.utf16()), (size_t)text.size(), lowercase.data(), classes.data());
+
+	std::vector<std::pair<char16_t, bool>> characters;
+	for (size_t i = 0; i < lowercase.size(); ++i)
+	{
+		if ((classes[i] & CCharacterTokenizer::Space) == 0)
+			characters.emplace_back(lowercase[i], (classes[i] & CCharacterTokenizer::Letter) != 0);
+	}
+
+	return characters;
+}
+
+// A shard continues the trigrams of the text before it: once the first trigram is complete, the parser state is nothing but the last 3 non-space characters.
+// The first trigram takes 3 letters (any other characters before them are ignored) and must be followed by 3 more characters for that to hold,
+// so a file is only split if it gets there within the first 64 KB, which the first shard boundary is far beyond.
+static bool canBeSplitIntoShards(const char* data, const qint64 size)
+{
+	QString head;
+	decodeUtf8(data, 0, characterStart(data, size, std::min(size, qint64{64} * 1024)), [&head](const QString& text) {
+		head += text;
+	});
+
+	int numLetters = 0, numCharactersAfterFirstTrigram = 0;
+	for (const auto& character: nonSpaceCharacters(head))
+	{
+		if (numLetters < 3)
+			numLetters += character.second ? 1 : 0;
+		else if (++numCharactersAfterFirstTrigram == 3)
+			return true;
+	}
+
+	return false;
+}
+
+// The parser state at a shard boundary past the first trigram: the last 3 non-space characters before it, found by decoding a growing piece of the preceding text
+static CTextParser::TrigramState trigramStateAt(const char* data, const qint64 position)
+{
+	CTextParser::TrigramState state;
+	for (qint64 lookBehind = 64; ; lookBehind *= 2)
+	{
+		const qint64 start = characterStart(data, position, std::max(position - lookBehind, qint64{0}));
+		QString precedingText;
+		decodeUtf8(data, start, position, [&precedingText](const QString& text) {
+			precedingText += text;
+		});
+
+		const auto characters = nonSpaceCharacters(precedingText);
+		if (characters.size() < 3 && lookBehind < position)
+			continue;
+
+		for (size_t i = characters.size() - std::min(characters.size(), size_t{3}); i < characters.size(); ++i)
+			state.trigram = CTextParser::shiftTrigram(state.trigram, characters[i].first);
+
+		state.numLettersRead = 3;
+		return state;
+	}
+}
+
+static void merge(CTextParser::OccurrenceTable& target, const CTextParser::OccurrenceTable& source)
+{
+	target.trigramOccurrenceTable.merge(source.trigramOccurrenceTable);
+	target.totalTrigramsCount += source.totalTrigramsCount;
+}
+
+// Calls processItem(itemIndex, threadIndex) for every item; the threads take the next unprocessed item whenever they are done with the previous one
+template <typename ProcessItem>
+static void runOnThreads(const size_t numItems, const unsigned int numThreads, ProcessItem&& processItem)
+{
+	std::atomic<size_t> nextItemIndex{0};
+	std::vector<std::thread> threads;
+	for (unsigned int threadIndex = 0; threadIndex < numThreads; ++threadIndex)
+	{
+		threads.emplace_back([&, threadIndex]() {
+			for (size_t i = nextItemIndex++; i < numItems; i = nextItemIndex++)
+				processItem(i, threadIndex);
+		});
+	}
+
+	for (auto& thread: threads)
+		thread.join();
+}
+
+// Either a whole file or, for the large plain files in the --full mode, a shard of one
+struct WorkItem
+{
+	qsizetype fileIndex;
+	const char* mappedData = nullptr; // The mapping of the whole file if it's split into shards, nullptr otherwise
+	qint64 begin = 0;
+	qint64 end = 0;
+};
+
+// Counts are sums, so the result doesn't depend on how the files are distributed between the threads, and the output is identical to a serial run
+static CTextParser::OccurrenceTable countTrigrams(const QStringList& filePaths, unsigned int numThreads, const bool fullText)
+{
+	// The files that are split stay mapped until all their shards are counted. Compressed files and the ones that can't be mapped are counted whole.
+	std::vector<std::unique_ptr<QFile>> mappedFiles;
+	std::vector<WorkItem> workItems;
+	for (qsizetype fileIndex = 0; fileIndex < filePaths.size(); ++fileIndex)
+	{
+		const QString& filePath = filePaths[fileIndex];
+		const bool isCompressed = std::any_of(decompressors.begin(), decompressors.end(), [&filePath](const Decompressor& d) {
+			return filePath.endsWith(d.fileExtension, Qt::CaseInsensitive);
+		});
+
+		auto file = std::make_unique<QFile>(filePath);
+		const char* data = nullptr;
+		if (fullText && !isCompressed && file->open(QFile::ReadOnly) && file->size() > shardSize)
+			data = reinterpret_cast<const char*>(file->map(0, file->size()));
+
+		if (!data || !canBeSplitIntoShards(data, file->size()))
+		{
+			workItems.push_back({fileIndex});
+			continue;
+		}
+
+		const qint64 size = file->size();
+		for (qint64 begin = 0; begin < size;)
+		{
+			const qint64 end = characterStart(data, size, std::min(begin + shardSize, size));
+			workItems.push_back({fileIndex, data, begin, end});
+			begin = end;
+		}
+
+		mappedFiles.push_back(std::move(file));
+	}
+
+	numThreads = std::min(numThreads, (unsigned int)workItems.size());
+	std::vector<CTextParser> parsers(numThreads);
+	runOnThreads(workItems.size(), numThreads, [&](const size_t itemIndex, const unsigned int threadIndex) {
+		CTextParser& parser = parsers[threadIndex];
+		const WorkItem& item = workItems[itemIndex];
+		if (item.mappedData)
+		{
+			CTextParser::TrigramState state = item.begin > 0 ? trigramStateAt(item.mappedData, item.begin) : CTextParser::TrigramState();
+			decodeUtf8(item.mappedData, item.begin, item.end, [&](const QString& text) {
+				parser.parse(text, state);
+			});
+
+			return;
+		}
+
+		const QString& filePath = filePaths[item.fileIndex];
+		if (!parseFile(parser, filePath, fullText))
+		{
+			// One line per message, so that the output of different threads isn't interleaved mid-line
+			std::cout << ("Failed to parse " + filePath + "\nMake sure it's a UTF-8 text file or a supported archive of one.\n").toStdString() << std::flush;
+		}
+	});
+
+	std::vector<CTextParser::OccurrenceTable> tables;
+	for (const auto& parser: parsers)
+		tables.push_back(parser.parsingResult());
+
+	// Parallel reduction: every round merges the pairs of tables that are step apart, halving the number of tables
+	for (size_t step = 1; step < tables.size(); step *= 2)
+	{
+		const size_t numPairs = (tables.size() + step) / (2 * step);
+		runOnThreads(numPairs, numThreads, [&](const size_t pairIndex, unsigned int) {
+			const size_t target = pairIndex * 2 * step;
+			if (target + step < tables.size())
+				merge(tables[target], tables[target + step]);
+		});
+	}
+
+	return std::move(tables.front());
+}
+
+// The trigram as shown in the comment after its entry in the generated table. Only the first character of a trigram is a letter: a backslash at the end of the line
+// would splice the next entry into the comment, a slash could start or end a comment, and control characters or unpaired surrogates would corrupt the source,
+// so these are written as \uXXXX codes.
+static QString trigramComment(const CTextParser::Trigram trigram)
+{
+	QString comment;
+	for (const QChar ch: CTextParser::unpackTrigram(trigram))
+	{
+		if (ch == QChar('\\') || ch == QChar('/') || ch.isSurrogate() || !ch.isPrint())
+			comment += QString("\\u%1").arg((uint)ch.unicode(), 4, 16, QChar('0'));
+		else
+			comment += ch;
+	}
+
+	return comment;
 }
 
 int main(int argc, char *argv[])
 {
-	if (argc < 3)
+	unsigned int numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	bool fullText = false;
+	bool binaryOutput = false;
+	size_t topK = 0;
+
+	int argIndex = 1;
+	for (; argIndex < argc && QString(argv[argIndex]).startsWith("--"); ++argIndex)
+	{
+		const QString option(argv[argIndex]);
+		if (option.startsWith("--threads="))
+			numThreads = (unsigned int)std::max(option.mid(10).toInt(), 1);
+		else if (option == "--full")
+			fullText = true;
+		else if (option == "--binary")
+			binaryOutput = true;
+		else if (option.startsWith("--top-k=") && option.mid(8).toInt() > 0)
+			topK = (size_t)option.mid(8).toInt();
+		else
+		{
+			std::cout << "Unknown option " << argv[argIndex] << std::endl;
+			printUsageInstructions();
+			return -1;
+		}
+	}
+
+	if (argc - argIndex < 2)
 	{
 		printUsageInstructions();
 		return -1;
 	}
 
-	const QString languageName(argv[1]);
+	const QString languageName(argv[argIndex]);
 
-	CTextParser parser;
-	for (int i = 2; i < argc; ++i)
+	QStringList filePaths;
+	for (int i = argIndex + 1; i < argc; ++i)
+		filePaths.push_back(QString(argv[i]));
+
+	const CTextParser::OccurrenceTable occurrences = countTrigrams(filePaths, numThreads, fullText);
+
+	// Without --top-k, trigram with less than 0.05% occurrence rate are discarded
+	const quint64 thresholdTrigramCount = topK == 0 ? occurrences.totalTrigramsCount / 2000 : 0;
+	std::vector<std::pair<CTextParser::Trigram, quint64>> trigrams;
+	for (const auto& trigram: occurrences.trigramOccurrenceTable)
+	{
+		if (trigram.count >= thresholdTrigramCount)
+			trigrams.emplace_back(trigram.key, trigram.count);
+	}
+
+	if (topK > 0 && trigrams.size() > topK)
 	{
-		if (!parser.parse(QString(argv[i]), "UTF-8"))
+		// The ties are broken by the trigram, so that the result doesn't depend on the hash table order
+		std::nth_element(trigrams.begin(), trigrams.begin() + (ptrdiff_t)topK, trigrams.end(), [](const auto& l, const auto& r) {
+			return l.second != r.second ? l.second > r.second : l.first < r.first;
+		});
+		trigrams.resize(topK);
+	}
+
+	quint64 actualTotalCount = 0;
+	for (const auto& trigram: trigrams)
+		actualTotalCount += trigram.second;
+
+	std::sort(trigrams.begin(), trigrams.end());
+
+	std::vector<CTrigramFrequencyTable_Base::Entry> entries;
+	entries.reserve(trigrams.size());
+	for (const auto& trigram: trigrams)
+		entries.push_back({trigram.first, (float)trigram.second / (float)actualTotalCount});
+
+	const QString className = QString("CTrigramFrequencyTable_") + languageName;
+	if (binaryOutput)
+	{
+		const QString modelFileName = className.toLower() + ".bin";
+		if (!CTrigramFrequencyTable_File::save(modelFileName, languageName, entries))
 		{
-			std::cout << "Failed to parse" << argv[i] << std::endl;
-			std::cout << "Make sure it's a UTF-8 text file." << argv[i] << std::endl;
+			std::cout << "Failed to write " << modelFileName.toStdString() << std::endl;
+			return -1;
 		}
+
+		return 0;
 	}
 
-	const QString className = QString("CTrigramFrequencyTable_") + languageName;
 	const QString headerFileName = className.toLower() + ".h";
 	const QString cppFileName = className.toLower() + ".cpp";
 
@@ -96,22 +487,18 @@ int main(int argc, char *argv[])
 	outputFile.setFileName(cppFileName);
 	outputFile.open(QFile::WriteOnly);
 
-	QString constructorBody;
-	const QString constructorLineTemplate("\t\t{\"%1\", %2ull},\n");
-	auto sortedTable = flip_map(parser.parsingResult().trigramOccurrenceTable);
-
-	const quint64 thresholdTrigramCount = parser.parsingResult().totalTrigramsCount / 2000; // Trigram with less than 0.05% occurrence rate are discarded
-	quint64 actualTotalCount = 0;
-	for (auto it = sortedTable.rbegin(); it != sortedTable.rend(); ++it)
+	QString tableBody;
+	const QString tableLineTemplate("\t{0x%1ull, %2f}, // %3\n");
+	for (const auto& entry: entries)
 	{
-		if (it->first < thresholdTrigramCount)
-			break;
+		QString frequencyLiteral = QString::number(entry.frequency, 'g', 9); // 9 significant digits are enough to restore the exact float value
+		if (!frequencyLiteral.contains('.') && !frequencyLiteral.contains('e'))
+			frequencyLiteral += ".0";
 
-		constructorBody.append(constructorLineTemplate.arg(it->second).arg(it->first));
-		actualTotalCount += it->first;
+		tableBody.append(tableLineTemplate.arg(entry.trigram, 16, 16, QChar('0')).arg(frequencyLiteral, trigramComment(entry.trigram)));
 	}
 
-	stream << tableClassCppTemplate.arg(headerFileName).arg(languageName).arg(actualTotalCount).arg(constructorBody);
+	stream << tableClassCppTemplate.arg(headerFileName, languageName, tableBody);
 
 	return 0;
 }
@@ -1,7 +1,7 @@
 DESTDIR  = bin
 TARGET = text_analyzer
 TEMPLATE = app
-CONFIG += staticlib c++11 console
+CONFIG += staticlib c++17 console thread
 
 QT = core
 
@@ -8,3 +8,15 @@ build_analyzer{
 	sub_analyzer.subdir = text-analyzer
 	sub_analyzer.depends = sub_detector
 }
+
+build_benchmark{
+	SUBDIRS += sub_benchmark
+	sub_benchmark.subdir = match-benchmark
+	sub_benchmark.depends = sub_detector
+}
+
+build_tests{
+	SUBDIRS += sub_tests
+	sub_tests.subdir = tests
+	sub_tests.depends = sub_detector
+}
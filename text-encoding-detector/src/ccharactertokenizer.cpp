@@ -0,0 +1,172 @@
+#include "ccharactertokenizer.h"
+
+DISABLE_COMPILER_WARNINGS
+#include <QChar>
+RESTORE_COMPILER_WARNINGS
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#define TOKENIZER_SSE2
+#include <emmintrin.h>
+#endif
+
+// The AVX2 code is compiled regardless of the compiler flags and only called if the CPU supports it
+#if defined TOKENIZER_SSE2 && (defined __GNUC__ || defined __clang__)
+#define TOKENIZER_AVX2
+#define TOKENIZER_AVX2_FUNCTION __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined TOKENIZER_SSE2 && defined _MSC_VER
+#define TOKENIZER_AVX2
+#define TOKENIZER_AVX2_FUNCTION
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+using TokenizeFunction = void (*)(const char16_t* text, size_t length, char16_t* lowercase, quint8* classes);
+
+static void tokenizeScalar(const char16_t* text, size_t length, char16_t* lowercase, quint8* classes)
+{
+	for (size_t i = 0; i < length; ++i)
+	{
+		const QChar ch(text[i]);
+		lowercase[i] = ch.toLower().unicode();
+		classes[i] = (quint8)((ch.isLetter() ? CCharacterTokenizer::Letter : 0) | (ch.isSpace() ? CCharacterTokenizer::Space : 0));
+	}
+}
+
+// The vectorized paths handle the blocks where every character is either ASCII or basic Cyrillic (U+0400 - U+045F):
+// - ASCII: A-Z and a-z are the only letters, A-Z is lowercased by adding 0x20, and the whitespace is U+0009 - U+000D and U+0020;
+// - U+0400 - U+045F are all letters: U+0400 - U+040F lowercase to U+0450 - U+045F, U+0410 - U+042F to U+0430 - U+044F, the rest is lowercase already.
+
+#ifdef TOKENIZER_SSE2
+
+// Unsigned 16-bit comparison (value < bound): SSE2 only has the signed one, so both sides are shifted by 0x8000
+static inline __m128i below(const __m128i value, const quint16 bound)
+{
+	return _mm_cmplt_epi16(_mm_xor_si128(value, _mm_set1_epi16((short)0x8000)), _mm_set1_epi16((short)(bound ^ 0x8000u)));
+}
+
+static void tokenizeSse2(const char16_t* text, size_t length, char16_t* lowercase, quint8* classes)
+{
+	size_t i = 0;
+	for (; i + 8 <= length; i += 8)
+	{
+		const __m128i characters = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+		const __m128i isAscii = below(characters, 0x80);
+		const __m128i cyrillicOffset = _mm_sub_epi16(characters, _mm_set1_epi16(0x400));
+		const __m128i isCyrillic = below(cyrillicOffset, 0x60);
+		if (_mm_movemask_epi8(_mm_or_si128(isAscii, isCyrillic)) != 0xFFFF)
+		{
+			tokenizeScalar(text + i, 8, lowercase + i, classes + i);
+			continue;
+		}
+
+		const __m128i isUppercaseAscii = below(_mm_sub_epi16(characters, _mm_set1_epi16('A')), 26);
+		const __m128i isLowercaseAscii = below(_mm_sub_epi16(characters, _mm_set1_epi16('a')), 26);
+		const __m128i isUppercaseCyrillicExtension = below(cyrillicOffset, 0x10);
+		const __m128i isUppercaseCyrillicBasic = below(_mm_sub_epi16(cyrillicOffset, _mm_set1_epi16(0x10)), 0x20);
+
+		const __m128i lowercaseDelta = _mm_or_si128(
+			_mm_and_si128(_mm_or_si128(isUppercaseAscii, isUppercaseCyrillicBasic), _mm_set1_epi16(0x20)),
+			_mm_and_si128(isUppercaseCyrillicExtension, _mm_set1_epi16(0x50)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lowercase + i), _mm_add_epi16(characters, lowercaseDelta));
+
+		const __m128i isLetter = _mm_or_si128(_mm_or_si128(isUppercaseAscii, isLowercaseAscii), isCyrillic);
+		const __m128i isSpace = _mm_or_si128(_mm_cmpeq_epi16(characters, _mm_set1_epi16(' ')), below(_mm_sub_epi16(characters, _mm_set1_epi16(0x09)), 5));
+		const __m128i characterClasses = _mm_or_si128(
+			_mm_and_si128(isLetter, _mm_set1_epi16(CCharacterTokenizer::Letter)),
+			_mm_and_si128(isSpace, _mm_set1_epi16(CCharacterTokenizer::Space)));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(classes + i), _mm_packus_epi16(characterClasses, characterClasses));
+	}
+
+	tokenizeScalar(text + i, length - i, lowercase + i, classes + i);
+}
+
+#endif // TOKENIZER_SSE2
+
+#ifdef TOKENIZER_AVX2
+
+TOKENIZER_AVX2_FUNCTION static inline __m256i below(const __m256i value, const quint16 bound)
+{
+	return _mm256_cmpgt_epi16(_mm256_set1_epi16((short)(bound ^ 0x8000u)), _mm256_xor_si256(value, _mm256_set1_epi16((short)0x8000)));
+}
+
+TOKENIZER_AVX2_FUNCTION static void tokenizeAvx2(const char16_t* text, size_t length, char16_t* lowercase, quint8* classes)
+{
+	size_t i = 0;
+	for (; i + 16 <= length; i += 16)
+	{
+		const __m256i characters = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+		const __m256i isAscii = below(characters, 0x80);
+		const __m256i cyrillicOffset = _mm256_sub_epi16(characters, _mm256_set1_epi16(0x400));
+		const __m256i isCyrillic = below(cyrillicOffset, 0x60);
+		if (_mm256_movemask_epi8(_mm256_or_si256(isAscii, isCyrillic)) != -1)
+		{
+			tokenizeScalar(text + i, 16, lowercase + i, classes + i);
+			continue;
+		}
+
+		const __m256i isUppercaseAscii = below(_mm256_sub_epi16(characters, _mm256_set1_epi16('A')), 26);
+		const __m256i isLowercaseAscii = below(_mm256_sub_epi16(characters, _mm256_set1_epi16('a')), 26);
+		const __m256i isUppercaseCyrillicExtension = below(cyrillicOffset, 0x10);
+		const __m256i isUppercaseCyrillicBasic = below(_mm256_sub_epi16(cyrillicOffset, _mm256_set1_epi16(0x10)), 0x20);
+
+		const __m256i lowercaseDelta = _mm256_or_si256(
+			_mm256_and_si256(_mm256_or_si256(isUppercaseAscii, isUppercaseCyrillicBasic), _mm256_set1_epi16(0x20)),
+			_mm256_and_si256(isUppercaseCyrillicExtension, _mm256_set1_epi16(0x50)));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(lowercase + i), _mm256_add_epi16(characters, lowercaseDelta));
+
+		const __m256i isLetter = _mm256_or_si256(_mm256_or_si256(isUppercaseAscii, isLowercaseAscii), isCyrillic);
+		const __m256i isSpace = _mm256_or_si256(_mm256_cmpeq_epi16(characters, _mm256_set1_epi16(' ')), below(_mm256_sub_epi16(characters, _mm256_set1_epi16(0x09)), 5));
+		const __m256i characterClasses = _mm256_or_si256(
+			_mm256_and_si256(isLetter, _mm256_set1_epi16(CCharacterTokenizer::Letter)),
+			_mm256_and_si256(isSpace, _mm256_set1_epi16(CCharacterTokenizer::Space)));
+		// packus works within the 128-bit lanes; the permutation brings the low halves of both lanes together
+		const __m256i packedClasses = _mm256_permute4x64_epi64(_mm256_packus_epi16(characterClasses, characterClasses), 0x08);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(classes + i), _mm256_castsi256_si128(packedClasses));
+	}
+
+	tokenizeSse2(text + i, length - i, lowercase + i, classes + i);
+}
+
+static bool cpuSupportsAvx2()
+{
+#ifdef _MSC_VER
+	int cpuInfo[4];
+	__cpuid(cpuInfo, 0);
+	if (cpuInfo[0] < 7)
+		return false;
+
+	__cpuid(cpuInfo, 1);
+	// AVX and OSXSAVE, and the OS saves the XMM and YMM state
+	const bool avxUsable = (cpuInfo[2] & (1 << 28)) != 0 && (cpuInfo[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+	if (!avxUsable)
+		return false;
+
+	__cpuidex(cpuInfo, 7, 0);
+	return (cpuInfo[1] & (1 << 5)) != 0;
+#else
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // TOKENIZER_AVX2
+
+static TokenizeFunction selectImplementation()
+{
+#ifdef TOKENIZER_AVX2
+	if (cpuSupportsAvx2())
+		return tokenizeAvx2;
+#endif
+
+#ifdef TOKENIZER_SSE2
+	return tokenizeSse2;
+#else
+	return tokenizeScalar;
+#endif
+}
+
+void CCharacterTokenizer::tokenize(const char16_t* text, size_t length, char16_t* lowercase, quint8* classes)
+{
+	static const TokenizeFunction implementation = selectImplementation();
+	implementation(text, length, lowercase, classes);
+}
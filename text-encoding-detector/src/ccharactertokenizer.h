@@ -0,0 +1,24 @@
+#pragma once
+
+#include "compiler/compiler_warnings_control.h"
+
+DISABLE_COMPILER_WARNINGS
+#include <QtGlobal>
+RESTORE_COMPILER_WARNINGS
+
+#include <stddef.h>
+
+// Classifies and lowercases UTF-16 text in blocks, with exactly the semantics of QChar::isLetter(), QChar::isSpace() and QChar::toLower().
+// Blocks consisting of ASCII and basic Cyrillic (U+0400 - U+045F) characters are processed with SSE2 or AVX2, whichever the CPU supports (chosen at runtime);
+// any other code point falls back to QChar for its block.
+class CCharacterTokenizer
+{
+public:
+	enum CharacterClass : quint8 {
+		Letter = 1,
+		Space = 2
+	};
+
+	// Writes the lowercase form and the CharacterClass flags of every UTF-16 unit of the text into the output arrays, which must hold length elements each
+	static void tokenize(const char16_t* text, size_t length, char16_t* lowercase, quint8* classes);
+};
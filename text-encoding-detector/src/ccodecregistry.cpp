@@ -0,0 +1,88 @@
+#include "ccodecregistry.h"
+
+#include "qtcore_helpers/qstring_helpers.hpp"
+
+DISABLE_COMPILER_WARNINGS
+#include <QTextCodec>
+RESTORE_COMPILER_WARNINGS
+
+#include <algorithm>
+
+#include <ctype.h>
+
+static std::string toLowerAscii(const char* name)
+{
+	std::string lowercaseName(name);
+	for (char& ch: lowercaseName)
+		ch = (char)tolower((unsigned char)ch);
+
+	return lowercaseName;
+}
+
+const CCodecRegistry& CCodecRegistry::instance()
+{
+	// Thread-safe initialization of function-local statics is guaranteed since C++11
+	static const CCodecRegistry registry;
+	return registry;
+}
+
+CCodecRegistry::CCodecRegistry()
+{
+	std::vector<Codec*> candidates;
+	// Several names may refer to the same codec; unlike a set, the vector has a fixed order, so the detection results are reproducible
+	for (const QByteArray& codecName: QTextCodec::availableCodecs())
+	{
+		QTextCodec* codec = QTextCodec::codecForName(codecName);
+		if (!codec)
+			continue;
+
+		auto it = _codecsByHandle.find(codec);
+		if (it == _codecsByHandle.end())
+		{
+			_codecs.push_back(std::make_unique<Codec>(Codec{codec, QString(codec->name()), CSingleByteCodecTable::create(*codec)}));
+			it = _codecsByHandle.emplace(codec, _codecs.back().get()).first;
+
+			if (!QString(codec->name()).contains(QSL("utf-8"), Qt::CaseInsensitive))
+				candidates.push_back(_codecs.back().get());
+		}
+
+		_codecsByLowercaseName.emplace(toLowerAscii(codecName.constData()), it->second);
+	}
+
+	// The most widespread encodings go first: with Options::earlyExitMatch, they are the likeliest to end the scoring early
+	static const char* const commonCodecNames[] = {"windows-1252", "windows-1251", "KOI8-R", "UTF-16LE", "UTF-16BE", "IBM866", "ISO-8859-5", "ISO-8859-1"};
+	auto insertionPoint = candidates.begin();
+	for (const char* codecName: commonCodecNames)
+	{
+		const Codec* codec = find(codecName);
+		const auto it = std::find(insertionPoint, candidates.end(), codec);
+		if (codec && it != candidates.end())
+			insertionPoint = std::rotate(insertionPoint, it, it + 1);
+	}
+
+	std::vector<const CSingleByteCodecTable*> singleByteTables;
+	for (Codec* candidate: candidates)
+	{
+		if (candidate->singleByteTable)
+		{
+			candidate->singleByteCodecSetIndex = singleByteTables.size();
+			singleByteTables.push_back(candidate->singleByteTable.get());
+		}
+	}
+
+	_candidates.assign(candidates.begin(), candidates.end());
+
+	_singleByteCodecSet = CSingleByteCodecSet(singleByteTables);
+}
+
+const CCodecRegistry::Codec* CCodecRegistry::find(const char* name) const
+{
+	const auto it = _codecsByLowercaseName.find(toLowerAscii(name));
+	return it != _codecsByLowercaseName.end() ? it->second : nullptr;
+}
+
+const CCodecRegistry::Codec* CCodecRegistry::find(const QTextCodec* codec) const
+{
+	const auto it = _codecsByHandle.find(codec);
+	return it != _codecsByHandle.end() ? it->second : nullptr;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "csinglebytecodectable.h"
+
+DISABLE_COMPILER_WARNINGS
+#include <QString>
+RESTORE_COMPILER_WARNINGS
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class QTextCodec;
+
+// The process-wide list of codecs with everything the detection needs to know about them, built once on first use and immutable afterwards,
+// so detectors share it and no codec name lookups or per-call allocations are needed. Safe to use from any thread.
+class CCodecRegistry
+{
+public:
+	struct Codec
+	{
+		QTextCodec* codec;
+		QString name; // codec->name(), converted once
+		std::unique_ptr<const CSingleByteCodecTable> singleByteTable; // nullptr for the multibyte and stateful codecs
+		size_t singleByteCodecSetIndex = 0; // The position of singleByteTable in singleByteCodecSet()
+	};
+
+	[[nodiscard]] static const CCodecRegistry& instance();
+
+	// The codecs scored by the detection, each one once regardless of its aliases, the most widespread encodings first.
+	// UTF-8 is not among them: the byte-level pre-pass recognizes it.
+	[[nodiscard]] inline const std::vector<const Codec*>& candidates() const {return _candidates;}
+	// All the single-byte candidates, in the order of candidates()
+	[[nodiscard]] inline const CSingleByteCodecSet& singleByteCodecSet() const {return _singleByteCodecSet;}
+
+	// Any codec by any of its names or aliases, case-insensitively; nullptr if there is no such codec.
+	// Builds a lowercase copy of the name, so it's meant for resolving the codecs once rather than for the per-call paths.
+	[[nodiscard]] const Codec* find(const char* name) const;
+	[[nodiscard]] const Codec* find(const QTextCodec* codec) const;
+
+	CCodecRegistry(const CCodecRegistry&) = delete;
+	CCodecRegistry& operator=(const CCodecRegistry&) = delete;
+
+private:
+	CCodecRegistry();
+
+private:
+	std::vector<std::unique_ptr<Codec>> _codecs;
+	std::vector<const Codec*> _candidates;
+	CSingleByteCodecSet _singleByteCodecSet;
+	std::unordered_map<std::string, const Codec*> _codecsByLowercaseName;
+	std::unordered_map<const QTextCodec*, const Codec*> _codecsByHandle;
+};
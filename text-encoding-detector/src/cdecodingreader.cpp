@@ -0,0 +1,106 @@
+#include "cdecodingreader.h"
+#include "ctextsample.h"
+#include "assert/advanced_assert.h"
+
+DISABLE_COMPILER_WARNINGS
+#include <QIODevice>
+RESTORE_COMPILER_WARNINGS
+
+#include <algorithm>
+
+CDecodingReader::CDecodingReader(QIODevice& device, const QTextCodec& codec, QByteArray bufferedPrefix, qint64 chunkSize) :
+	_device(device),
+	_codec(codec),
+	_decoder(&codec),
+	_bufferedPrefix(std::move(bufferedPrefix))
+{
+	assert_r(chunkSize > 0);
+	// QTextDecoder takes the length as int
+	_readBuffer.resize((qsizetype)std::clamp(chunkSize, qint64{4}, qint64{1024} * 1024 * 1024));
+}
+
+CDecodingReader::CDecodingReader(std::unique_ptr<QIODevice> device, const QTextCodec& codec, QByteArray bufferedPrefix, qint64 chunkSize) :
+	CDecodingReader(*device, codec, std::move(bufferedPrefix), chunkSize)
+{
+	_ownedDevice = std::move(device);
+}
+
+CDecodingReader::~CDecodingReader() = default;
+
+QString CDecodingReader::encoding() const
+{
+	return QString(_codec.name());
+}
+
+bool CDecodingReader::readChunk(QString& chunk)
+{
+	chunk.clear();
+	if (_endReached)
+		return false;
+
+	// A chunk that only holds the beginning of a multibyte sequence produces no text, the decoder keeps it for the next one
+	while (chunk.isEmpty())
+	{
+		if (!_bufferedPrefix.isEmpty())
+		{
+			_decoder.toUnicode(&chunk, _bufferedPrefix.constData(), (int)_bufferedPrefix.size());
+			_bufferedPrefix = QByteArray();
+			continue;
+		}
+
+		const qint64 numBytesRead = readBytes();
+		if (numBytesRead <= 0)
+		{
+			_endReached = true;
+			// A multibyte sequence cut off by the end of the input is still held by the decoder; it becomes a replacement character, same as with QTextCodec::toUnicode()
+			if (_readError || !_decoder.needsMoreData())
+				return false;
+
+			chunk = QChar(QChar::ReplacementCharacter);
+			return true;
+		}
+
+		_decoder.toUnicode(&chunk, _readBuffer.constData(), (int)numBytesRead);
+	}
+
+	return true;
+}
+
+bool CDecodingReader::readAll(const TextChunkCallback& onChunk)
+{
+	QString chunk;
+	while (readChunk(chunk))
+	{
+		if (!onChunk(chunk))
+			return false;
+	}
+
+	return !_readError;
+}
+
+bool CDecodingReader::readAllAsUtf8(const Utf8ChunkCallback& onChunk)
+{
+	return readAll([&onChunk](const QString& chunk) {
+		return onChunk(chunk.toUtf8());
+	});
+}
+
+qint64 CDecodingReader::readBytes()
+{
+	for (;;)
+	{
+		const qint64 numBytesRead = _device.read(_readBuffer.data(), _readBuffer.size());
+		if (numBytesRead > 0)
+			return numBytesRead;
+
+		if (numBytesRead < 0)
+		{
+			_readError = true;
+			return 0;
+		}
+
+		// A sequential device may simply have no data available yet; one that stays silent for too long is treated as having ended
+		if (!_device.isSequential() || !_device.waitForReadyRead(CTextSample::sequentialReadTimeoutMs))
+			return 0;
+	}
+}
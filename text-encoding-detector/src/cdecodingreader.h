@@ -0,0 +1,65 @@
+#pragma once
+
+#include "compiler/compiler_warnings_control.h"
+
+DISABLE_COMPILER_WARNINGS
+#include <QByteArray>
+#include <QString>
+#include <QTextCodec>
+RESTORE_COMPILER_WARNINGS
+
+#include <functional>
+#include <memory>
+
+class QIODevice;
+
+// Converts a device of any size to text incrementally, in chunks of a fixed number of bytes, so the memory use is bounded by the chunk size.
+// The decoder is stateful: multibyte sequences split between two chunks are converted correctly.
+// Created by CTextEncodingDetector::decodeStreaming(), which detects the encoding from a bounded sample first.
+class CDecodingReader
+{
+public:
+	// Return false to stop reading
+	using TextChunkCallback = std::function<bool (const QString& chunk)>;
+	using Utf8ChunkCallback = std::function<bool (const QByteArray& chunk)>;
+
+	static constexpr qint64 defaultChunkSize = 1024 * 1024;
+
+	// bufferedPrefix: the bytes that have already been read from a sequential device, they are converted before the rest of the device
+	CDecodingReader(QIODevice& device, const QTextCodec& codec, QByteArray bufferedPrefix = QByteArray(), qint64 chunkSize = defaultChunkSize);
+	// Same, but the reader owns the device (e.g. a QFile it has been opened for)
+	CDecodingReader(std::unique_ptr<QIODevice> device, const QTextCodec& codec, QByteArray bufferedPrefix = QByteArray(), qint64 chunkSize = defaultChunkSize);
+	~CDecodingReader();
+
+	CDecodingReader(const CDecodingReader&) = delete;
+	CDecodingReader& operator=(const CDecodingReader&) = delete;
+
+	[[nodiscard]] QString encoding() const;
+	[[nodiscard]] QString language() const {return _language;}
+	void setLanguage(const QString& language) {_language = language;}
+
+	// Converts the next chunk into the supplied string, reusing its buffer. Returns false at the end of the input or on a read error.
+	// A sequential device that has no new data for CTextSample::sequentialReadTimeoutMs counts as ended.
+	bool readChunk(QString& chunk);
+
+	// Pull all the remaining text through the callback. Returns true if the end of the input has been reached, false if the callback stopped the reading or on a read error.
+	bool readAll(const TextChunkCallback& onChunk);
+	bool readAllAsUtf8(const Utf8ChunkCallback& onChunk);
+
+	[[nodiscard]] bool hasReadError() const {return _readError;}
+
+private:
+	// Returns the number of bytes read into _readBuffer, 0 at the end of the input
+	qint64 readBytes();
+
+private:
+	std::unique_ptr<QIODevice> _ownedDevice;
+	QIODevice& _device;
+	const QTextCodec& _codec;
+	QTextDecoder _decoder;
+	QByteArray _bufferedPrefix;
+	QByteArray _readBuffer;
+	QString _language;
+	bool _readError = false;
+	bool _endReached = false;
+};
@@ -0,0 +1,174 @@
+#include "cencodingpreclassifier.h"
+#include "ctextsample.h"
+
+#include <array>
+#include <iterator>
+
+#include <string.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#define PRECLASSIFIER_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// The number of 7-bit bytes at the beginning of the data
+static size_t asciiPrefixLength(const unsigned char* data, size_t size)
+{
+	size_t i = 0;
+#ifdef PRECLASSIFIER_SSE2
+	for (; i + 16 <= size; i += 16)
+	{
+		const int highBits = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+		if (highBits != 0)
+		{
+#ifdef _MSC_VER
+			unsigned long firstNonAscii;
+			_BitScanForward(&firstNonAscii, (unsigned long)highBits);
+			return i + firstNonAscii;
+#else
+			return i + (size_t)__builtin_ctz((unsigned int)highBits);
+#endif
+		}
+	}
+#endif
+
+	while (i < size && data[i] < 0x80)
+		++i;
+
+	return i;
+}
+
+static constexpr struct {
+	const char* bom;
+	size_t length;
+	const char* codecName;
+} byteOrderMarks[] = {
+	// UTF-32LE must be checked before UTF-16LE as they start with the same two bytes
+	{"\xFF\xFE\x00\x00", 4, "UTF-32LE"},
+	{"\x00\x00\xFE\xFF", 4, "UTF-32BE"},
+	{"\xEF\xBB\xBF", 3, "UTF-8"},
+	{"\xFF\xFE", 2, "UTF-16LE"},
+	{"\xFE\xFF", 2, "UTF-16BE"},
+};
+
+// The index in byteOrderMarks, or std::size(byteOrderMarks) if the data doesn't start with a byte order mark
+static size_t byteOrderMarkIndex(const char* data, const size_t size)
+{
+	for (size_t i = 0; i < std::size(byteOrderMarks); ++i)
+	{
+		if (size >= byteOrderMarks[i].length && memcmp(data, byteOrderMarks[i].bom, byteOrderMarks[i].length) == 0)
+			return i;
+	}
+
+	return std::size(byteOrderMarks);
+}
+
+CEncodingPreClassifier::Verdict CEncodingPreClassifier::classify(const CTextSample& sample)
+{
+	// The registry is immutable, so the codecs of the verdicts are looked up by name only once
+	static const auto byteOrderMarkCodecs = [] {
+		std::array<const CCodecRegistry::Codec*, std::size(byteOrderMarks)> codecs;
+		for (size_t i = 0; i < codecs.size(); ++i)
+			codecs[i] = CCodecRegistry::instance().find(byteOrderMarks[i].codecName);
+
+		return codecs;
+	}();
+	static const CCodecRegistry::Codec* const utf8Codec = CCodecRegistry::instance().find("UTF-8");
+
+	Verdict verdict;
+	if (sample.isEmpty())
+		return verdict;
+
+	const QByteArray& firstWindow = sample.windows().front();
+	const size_t bomIndex = byteOrderMarkIndex(firstWindow.constData(), (size_t)firstWindow.size());
+	if (bomIndex < std::size(byteOrderMarks))
+	{
+		verdict.codec = byteOrderMarkCodecs[bomIndex];
+		verdict.fromByteOrderMark = true;
+		verdict.isCertain = verdict.codec != nullptr;
+		return verdict;
+	}
+
+	// Pure ASCII is reported as UTF-8: it decodes to the same text
+	const bool isSampled = !sample.isComplete();
+	for (size_t i = 0, n = sample.windows().size(); i < n; ++i)
+	{
+		const QByteArray& window = sample.windows()[i];
+		if (validateUtf8(window.constData(), (size_t)window.size(), i > 0, isSampled) == Utf8Validity::Invalid)
+			return verdict;
+	}
+
+	verdict.codec = utf8Codec;
+	verdict.isCertain = utf8Codec && sample.isComplete();
+	return verdict;
+}
+
+const char* CEncodingPreClassifier::codecForByteOrderMark(const char* data, size_t size)
+{
+	const size_t index = byteOrderMarkIndex(data, size);
+	return index < std::size(byteOrderMarks) ? byteOrderMarks[index].codecName : nullptr;
+}
+
+CEncodingPreClassifier::Utf8Validity CEncodingPreClassifier::validateUtf8(const char* data, size_t size, bool startsMidStream, bool endsMidStream)
+{
+	const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+	size_t i = 0;
+	if (startsMidStream)
+	{
+		// Skipping the tail of a sequence that started before the window
+		while (i < size && i < 3 && (bytes[i] & 0xC0) == 0x80)
+			++i;
+	}
+
+	bool multibyteSequenceFound = false;
+	while (i < size)
+	{
+		// The SIMD scan skips the 7-bit runs, which make up most of the text in many languages; the multibyte sequences are checked one by one
+		i += asciiPrefixLength(bytes + i, size - i);
+		if (i >= size)
+			break;
+
+		const unsigned char lead = bytes[i];
+		size_t sequenceLength;
+		unsigned char minSecondByte = 0x80, maxSecondByte = 0xBF;
+		if (lead >= 0xC2 && lead <= 0xDF)
+			sequenceLength = 2;
+		else if (lead >= 0xE0 && lead <= 0xEF)
+		{
+			sequenceLength = 3;
+			if (lead == 0xE0)
+				minSecondByte = 0xA0; // Overlong
+			else if (lead == 0xED)
+				maxSecondByte = 0x9F; // Surrogates
+		}
+		else if (lead >= 0xF0 && lead <= 0xF4)
+		{
+			sequenceLength = 4;
+			if (lead == 0xF0)
+				minSecondByte = 0x90; // Overlong
+			else if (lead == 0xF4)
+				maxSecondByte = 0x8F; // Above U+10FFFF
+		}
+		else
+			return Utf8Validity::Invalid; // A stray continuation byte, an overlong 2-byte lead (0xC0, 0xC1) or a byte that never occurs in UTF-8
+
+		for (size_t k = 1; k < sequenceLength; ++k)
+		{
+			if (i + k >= size)
+				return endsMidStream ? (multibyteSequenceFound ? Utf8Validity::Valid : Utf8Validity::Ascii) : Utf8Validity::Invalid;
+
+			const unsigned char continuation = bytes[i + k];
+			if (k == 1 ? (continuation < minSecondByte || continuation > maxSecondByte) : (continuation & 0xC0) != 0x80)
+				return Utf8Validity::Invalid;
+		}
+
+		multibyteSequenceFound = true;
+		i += sequenceLength;
+	}
+
+	return multibyteSequenceFound ? Utf8Validity::Valid : Utf8Validity::Ascii;
+}
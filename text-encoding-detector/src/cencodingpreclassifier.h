@@ -0,0 +1,35 @@
+#pragma once
+
+#include "ccodecregistry.h"
+
+#include <stddef.h>
+
+class CTextSample;
+
+// Byte-level checks that can identify the encoding for certain without any trigram statistics: byte order marks, pure 7-bit ASCII and valid UTF-8
+class CEncodingPreClassifier
+{
+public:
+	enum class Utf8Validity {
+		Invalid,
+		Ascii, // Only 7-bit characters: valid UTF-8 as well as valid in any ASCII-compatible encoding
+		Valid // Contains multibyte sequences, all of them well-formed
+	};
+
+	struct Verdict
+	{
+		const CCodecRegistry::Codec* codec = nullptr; // nullptr if the encoding could not be determined
+		bool fromByteOrderMark = false;
+		// A byte order mark is conclusive; ASCII and UTF-8 validity only if the sample is the whole input, the bytes between the windows could be anything
+		bool isCertain = false;
+	};
+
+	// The codecs are resolved in the registry once, on the first call, so no name lookups are done per call
+	[[nodiscard]] static Verdict classify(const CTextSample& sample);
+
+	// Returns the name of the codec indicated by a UTF-8, UTF-16 or UTF-32 byte order mark, or nullptr if there is none
+	[[nodiscard]] static const char* codecForByteOrderMark(const char* data, size_t size);
+
+	// startsMidStream / endsMidStream: the data is a window cut out of a larger input, so the first or the last sequence may have been cut off
+	[[nodiscard]] static Utf8Validity validateUtf8(const char* data, size_t size, bool startsMidStream, bool endsMidStream);
+};
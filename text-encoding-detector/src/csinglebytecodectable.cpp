@@ -0,0 +1,44 @@
+#include "csinglebytecodectable.h"
+
+DISABLE_COMPILER_WARNINGS
+#include <QTextCodec>
+RESTORE_COMPILER_WARNINGS
+
+std::unique_ptr<CSingleByteCodecTable> CSingleByteCodecTable::create(const QTextCodec& codec)
+{
+	char allBytes[256];
+	for (int i = 0; i < 256; ++i)
+		allBytes[i] = static_cast<char>(i);
+
+	// A single-byte codec decodes every byte into exactly one UTF-16 code unit, regardless of the bytes before it
+	QTextCodec::ConverterState state;
+	const QString decodedBytes = codec.toUnicode(allBytes, 256, &state);
+	if (decodedBytes.size() != 256)
+		return nullptr;
+
+	std::unique_ptr<CSingleByteCodecTable> table(new CSingleByteCodecTable);
+	for (int i = 0; i < 256; ++i)
+	{
+		QTextCodec::ConverterState singleByteState;
+		const QString decodedByte = codec.toUnicode(allBytes + i, 1, &singleByteState);
+		if (decodedByte.size() != 1 || decodedByte[0] != decodedBytes[i])
+			return nullptr;
+
+		const QChar ch = decodedBytes[i];
+		table->_lowercase[(size_t)i] = ch.toLower().unicode();
+		table->_flags[(size_t)i] = static_cast<quint8>((ch.isLetter() ? Letter : 0) | (ch.isSpace() ? Space : 0));
+	}
+
+	return table;
+}
+
+CSingleByteCodecSet::CSingleByteCodecSet(const std::vector<const CSingleByteCodecTable*>& codecTables) :
+	_numCodecs(codecTables.size())
+{
+	_byteClasses.reserve(256 * _numCodecs);
+	for (int byte = 0; byte < 256; ++byte)
+	{
+		for (const CSingleByteCodecTable* table: codecTables)
+			_byteClasses.push_back(ByteClass{table->lowercase((uchar)byte), table->isLetter((uchar)byte), table->isSpace((uchar)byte)});
+	}
+}
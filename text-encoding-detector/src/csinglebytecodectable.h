@@ -0,0 +1,65 @@
+#pragma once
+
+#include "compiler/compiler_warnings_control.h"
+
+DISABLE_COMPILER_WARNINGS
+#include <QtGlobal>
+RESTORE_COMPILER_WARNINGS
+
+#include <array>
+#include <memory>
+#include <vector>
+
+class QTextCodec;
+
+// The projection of a stateless single-byte codec (CP1251, KOI8-R, ISO-8859-x, CP866...) onto the trigram key space:
+// for every byte value, the lowercase character it decodes to and whether that character is a letter or whitespace.
+// With it, CTextParser turns the sample bytes into exactly the same trigrams it would get from the decoded text, without any Unicode conversion.
+class CSingleByteCodecTable
+{
+public:
+	// Returns nullptr if the codec is not a stateless single-byte one
+	[[nodiscard]] static std::unique_ptr<CSingleByteCodecTable> create(const QTextCodec& codec);
+
+	[[nodiscard]] inline char16_t lowercase(const uchar byte) const {return _lowercase[byte];}
+	[[nodiscard]] inline bool isLetter(const uchar byte) const {return (_flags[byte] & Letter) != 0;}
+	[[nodiscard]] inline bool isSpace(const uchar byte) const {return (_flags[byte] & Space) != 0;}
+
+private:
+	CSingleByteCodecTable() = default;
+
+private:
+	enum Flag : quint8 {
+		Letter = 1,
+		Space = 2
+	};
+
+	std::array<char16_t, 256> _lowercase;
+	std::array<quint8, 256> _flags;
+};
+
+// The tables of several single-byte codecs interleaved byte-major: the entries of all the codecs for one byte value are adjacent,
+// so one sample byte is classified for every codec with a single contiguous read. CTextParser uses it to score all these codecs in one pass over the sample.
+class CSingleByteCodecSet
+{
+public:
+	struct ByteClass
+	{
+		char16_t lowercase;
+		bool isLetter;
+		bool isSpace;
+	};
+
+	CSingleByteCodecSet() = default;
+	explicit CSingleByteCodecSet(const std::vector<const CSingleByteCodecTable*>& codecTables);
+
+	[[nodiscard]] inline size_t size() const {return _numCodecs;}
+	[[nodiscard]] inline bool empty() const {return _numCodecs == 0;}
+
+	// The classes of this byte for all the codecs, in the order of the tables passed to the constructor
+	[[nodiscard]] inline const ByteClass* row(const uchar byte) const {return _byteClasses.data() + byte * _numCodecs;}
+
+private:
+	std::vector<ByteClass> _byteClasses;
+	size_t _numCodecs = 0;
+};
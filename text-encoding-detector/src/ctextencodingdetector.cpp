@@ -1,143 +1,598 @@
 #include "ctextencodingdetector.h"
+#include "cencodingpreclassifier.h"
+#include "matchfunctions/cmatchfunction_l1.h"
 #include "trigramfrequencytables/ctrigramfrequencytable_english.h"
 #include "trigramfrequencytables/ctrigramfrequencytable_russian.h"
 
-#include "qtcore_helpers/qstring_helpers.hpp"
-
 #include "assert/advanced_assert.h"
 #include "lang/type_traits_fast.hpp"
 
 DISABLE_COMPILER_WARNINGS
 #include <QFile>
 #include <QIODevice>
+#include <QSemaphore>
 #include <QTextCodec>
+#include <QThreadPool>
 RESTORE_COMPILER_WARNINGS
 
 #include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <limits>
 #include <memory>
-#include <unordered_set>
+#include <mutex>
 
-#include <math.h>
+// Whether the best of the matches (sorted from high to low) leads the runner-up by at least gap, relative to the best match.
+// The candidates tied exactly with the best one (e.g. the codecs that decode the sample identically) can't be told apart by any amount of data, so they are skipped.
+static bool leadsRunnerUp(const std::vector<CTextEncodingDetector::EncodingDetectionResult>& sortedMatches, const float gap)
+{
+	const float bestMatch = sortedMatches.front().match;
+	const auto runnerUp = std::find_if(sortedMatches.cbegin(), sortedMatches.cend(), [bestMatch](const CTextEncodingDetector::EncodingDetectionResult& match) {return match.match < bestMatch;});
+	return runnerUp == sortedMatches.cend() || bestMatch - runnerUp->match >= gap * bestMatch;
+}
 
-static constexpr float plausibleMatchThreshold = 0.1f;
+// The largest input a QByteArray can hold: 2 GB with Qt 5
+static constexpr qint64 maxByteArraySize = std::numeric_limits<decltype(QByteArray().size())>::max();
+// The largest text a QString can hold, less the allocation header: about 1 G characters with Qt 5
+static constexpr qint64 maxStringSize = std::numeric_limits<decltype(QString().size())>::max() / (qint64)sizeof(QChar) - 64;
 
-inline float defaultMatchFunction(const CTextParser::OccurrenceTable& arg1, const CTextParser::OccurrenceTable& arg2)
+// Returns a QByteArray that references the mapped file contents without copying them; the mapping is only valid while the file is open.
+// Returns an empty array if the file cannot be mapped (e.g. it is empty or not a regular file), or if it's too large for a QByteArray,
+// in which case the callers read the file through QIODevice instead.
+static QByteArray mapFile(QFile& file)
 {
-	if (arg1.trigramOccurrenceTable.empty() || arg2.trigramOccurrenceTable.empty())
-		return 0.0f;
+	const qint64 size = file.size();
+	if (size <= 0 || size > maxByteArraySize)
+		return {};
 
-	const auto& largerTable = arg1.trigramOccurrenceTable.size() > arg2.trigramOccurrenceTable.size() ? arg1: arg2;
-	const auto& smallerTable = arg1.trigramOccurrenceTable.size() <= arg2.trigramOccurrenceTable.size() ? arg1: arg2;
+	const uchar* data = file.map(0, size);
+	return data ? QByteArray::fromRawData(reinterpret_cast<const char*>(data), size) : QByteArray();
+}
 
-	// Performance optimization: it's faster to make a smaller number of lookups into a larger hash map than vice versa.
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+// The largest piece of the input QTextDecoder is given at once: its lengths are int, while a QByteArray can be larger
+static constexpr qint64 maxDecoderPieceSize = std::numeric_limits<int>::max();
+#endif
 
-	float deviation = 0.0f;
-	for (const auto& n_gram1: smallerTable.trigramOccurrenceTable.asKeyValueRange())
-	{
-		const float n_gram1Ratio = (float)n_gram1.second / (float)smallerTable.totalTrigramsCount;
+// Unlike QIODevice::readAll(), waits for more data from sequential devices (processes, sockets) until the end of the stream.
+// A device that stays silent for longer than CTextSample::sequentialReadTimeoutMs counts as ended, same as when sampling it.
+static QByteArray readToEnd(QIODevice& device)
+{
+	QByteArray data = device.readAll();
+	if (!device.isSequential())
+		return data;
+
+	while (device.waitForReadyRead(CTextSample::sequentialReadTimeoutMs))
+		data.append(device.readAll());
+
+	data.append(device.readAll());
+	return data;
+}
+
+// Calls processItem(itemIndex, workerState) for every item on the calling thread and on the idle threads of the pool, if any.
+// processItem returns false to stop the processing of the remaining items.
+// The threads take the next unprocessed item from a shared counter whenever they are done with the previous one, so uneven items are balanced automatically.
+// Each thread has its own WorkerState (e.g. a parser), reused for all the items it processes.
+// Only the helpers that could start right away are waited for, so a busy pool never blocks the caller: the calling thread does the rest of the work.
+template <typename WorkerState, typename ProcessItem>
+static void runOnWorkers(const size_t numItems, QThreadPool* threadPool, ProcessItem&& processItem)
+{
+	std::atomic<size_t> nextItemIndex{0};
+	std::atomic<bool> stopRequested{false};
+	const auto worker = [&]() {
+		WorkerState workerState;
+		for (size_t i = nextItemIndex++; i < numItems && !stopRequested; i = nextItemIndex++)
+		{
+			if (!processItem(i, workerState))
+				stopRequested = true;
+		}
+	};
 
-		const auto n_gram2 = largerTable.trigramOccurrenceTable.find(n_gram1.first);
-		deviation += n_gram2 != largerTable.trigramOccurrenceTable.end() ?
-			fabs(n_gram1Ratio - (float)n_gram2.value() / (float)largerTable.totalTrigramsCount) :
-			n_gram1Ratio;
+	QSemaphore helpersFinished;
+	int numHelpersStarted = 0;
+	if (threadPool && numItems > 1)
+	{
+		const int maxHelpers = (int)std::min((size_t)threadPool->maxThreadCount(), numItems - 1);
+		for (; numHelpersStarted < maxHelpers; ++numHelpersStarted)
+		{
+			if (!threadPool->tryStart([&]() {
+				worker();
+				helpersFinished.release();
+			}))
+				break;
+		}
 	}
 
-	return deviation > 1e-5f ? (1.0f / deviation - 1.0f) : float_max;
+	worker();
+	helpersFinished.acquire(numHelpersStarted);
 }
 
-template <typename T>
-std::vector<CTextEncodingDetector::EncodingDetectionResult> detect(T& dataOrInputDevice, const std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>& tablesForLanguages)
+// Samples the file, from a memory mapping if possible, and runs the detection while the file (and thus the mapping) is open
+template <typename DetectFunction>
+static std::vector<CTextEncodingDetector::EncodingDetectionResult> detectInFile(const QString& textFilePath, const CTextSample::Parameters& sampling, DetectFunction&& detectFunction)
 {
-	const auto availableCodecs = QTextCodec::availableCodecs();
+	QFile file(textFilePath);
+	if (!file.open(QIODevice::ReadOnly))
+		return {};
+
+	const QByteArray mappedData = mapFile(file);
+	return detectFunction(mappedData.isEmpty() ? CTextSample::fromDevice(file, sampling) : CTextSample::fromData(mappedData, sampling));
+}
 
-	std::decay_t<decltype(tablesForLanguages)> defaultTables;
-	if (tablesForLanguages.empty())
+// A call takes a set of buffers out of the pool for its duration and returns it afterwards, so the concurrent calls each get their own set,
+// and the pool never holds more sets than there have been concurrent calls. The memory belongs to the detector and is freed with it.
+class CTextEncodingDetector::ParsingBuffersPool
+{
+public:
+	[[nodiscard]] std::unique_ptr<ParsingBuffers> acquire()
 	{
-		defaultTables.emplace_back(std::make_unique<CTrigramFrequencyTable_English>());
-		defaultTables.emplace_back(std::make_unique<CTrigramFrequencyTable_Russian>());
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (!_buffers.empty())
+			{
+				auto buffers = std::move(_buffers.back());
+				_buffers.pop_back();
+				return buffers;
+			}
+		}
+
+		return std::make_unique<ParsingBuffers>();
 	}
 
-	std::unordered_set<QTextCodec*> differentCodecs;
-	for (const auto& codecName : availableCodecs)
+	void release(std::unique_ptr<ParsingBuffers> buffers)
 	{
-		if (!QString(codecName).contains(QSL("utf-8"), Qt::CaseInsensitive))
-			differentCodecs.insert(QTextCodec::codecForName(codecName.data()));
+		std::lock_guard<std::mutex> lock(_mutex);
+		_buffers.push_back(std::move(buffers));
 	}
 
-	std::vector<CTextEncodingDetector::EncodingDetectionResult> match;
-	for (const auto& codec: differentCodecs)
+private:
+	std::mutex _mutex;
+	std::vector<std::unique_ptr<ParsingBuffers>> _buffers;
+};
+
+CTextEncodingDetector::CTextEncodingDetector(std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>> tablesForLanguages) :
+	CTextEncodingDetector(Options(), std::move(tablesForLanguages))
+{
+}
+
+CTextEncodingDetector::CTextEncodingDetector(const Options& options, std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>> tablesForLanguages) :
+	_options(options),
+	_tablesForLanguages(std::move(tablesForLanguages)),
+	_parsingBuffersPool(std::make_unique<ParsingBuffersPool>())
+{
+	if (_tablesForLanguages.empty())
 	{
-		CTextParser parser;
-		if (!parser.parse(dataOrInputDevice, QString(codec->name())))
-			continue;
+		_tablesForLanguages.emplace_back(std::make_unique<CTrigramFrequencyTable_English>());
+		_tablesForLanguages.emplace_back(std::make_unique<CTrigramFrequencyTable_Russian>());
+	}
 
-		const auto& languageStatisticsTables = tablesForLanguages.empty() ? defaultTables : tablesForLanguages;
-		for (const auto& table: languageStatisticsTables)
-			match.emplace_back(CTextEncodingDetector::EncodingDetectionResult{ codec->name(), table->language(), defaultMatchFunction(table->trigramOccurrenceTable(), parser.parsingResult()) });
+	std::vector<const CTrigramFrequencyTable_Base*> tables;
+	for (const auto& table: _tablesForLanguages)
+		tables.push_back(table.get());
+
+	if (_options.matchFunction)
+		_matchFunction = _options.matchFunction(tables);
+	if (!_matchFunction)
+		_matchFunction = std::make_unique<CMatchFunction_L1>(tables);
+}
+
+CTextEncodingDetector::CTextEncodingDetector(CTextEncodingDetector&&) noexcept = default;
+CTextEncodingDetector& CTextEncodingDetector::operator=(CTextEncodingDetector&&) noexcept = default;
+CTextEncodingDetector::~CTextEncodingDetector() = default;
+
+std::vector<CTextEncodingDetector::EncodingDetectionResult> CTextEncodingDetector::preClassify(const CTextSample& sample, CTextParser& parser, const CCodecRegistry::Codec*& likelyCodec) const
+{
+	likelyCodec = nullptr;
+	const auto verdict = CEncodingPreClassifier::classify(sample);
+	const CCodecRegistry::Codec* codec = verdict.codec;
+	if (!codec)
+		return {};
+
+	// The bytes between the sampled windows could be in any encoding (e.g. a windows-1251 file with long ASCII stretches), so the other codecs still have to be scored
+	if (!verdict.isCertain)
+	{
+		likelyCodec = codec;
+		return {};
 	}
 
-	std::sort(match.begin(), match.end(), [](const CTextEncodingDetector::EncodingDetectionResult& l, const CTextEncodingDetector::EncodingDetectionResult& r){return l.match > r.match;});
+	std::vector<EncodingDetectionResult> match;
+	if (_options.detectLanguageOfPreClassifiedText)
+	{
+		match = scoreCodec(sample, *codec, parser);
+		std::stable_sort(match.begin(), match.end(), [](const EncodingDetectionResult& l, const EncodingDetectionResult& r){return l.match > r.match;});
+	}
+
+	// Too few letters to tell the language, or the language wasn't requested
+	if (match.empty())
+		match.emplace_back(EncodingDetectionResult{ codec->name, QString(), float_max, false, codec->codec });
+
+	for (auto& result: match)
+		result.encodingIsCertain = true;
+
 	return match;
 }
 
+const std::vector<const CCodecRegistry::Codec*>& CTextEncodingDetector::candidateCodecs(const CTextSample& sample, const CCodecRegistry::Codec* likelyCodec, std::vector<const CCodecRegistry::Codec*>& orderedCandidates) const
+{
+	const auto& candidates = CCodecRegistry::instance().candidates();
+	const bool reorderByPriorLikelihood = _options.earlyExitMatch > 0.0f && !sample.isEmpty();
+	if (!likelyCodec && !reorderByPriorLikelihood)
+		return candidates;
+
+	auto& codecs = orderedCandidates;
+	codecs.assign(candidates.begin(), candidates.end());
+
+	// First, so that it's scored first and wins the ties (e.g. pure ASCII decodes the same in all the ASCII-compatible codecs); UTF-8 is not a candidate otherwise
+	auto insertionPoint = codecs.begin();
+	if (likelyCodec)
+	{
+		const auto it = std::find(codecs.begin(), codecs.end(), likelyCodec);
+		insertionPoint = it != codecs.end() ? std::rotate(codecs.begin(), it, it + 1) : codecs.insert(codecs.begin(), likelyCodec) + 1;
+	}
+
+	if (!reorderByPriorLikelihood)
+		return codecs;
+
+	// The prior likelihood: the codec indicated by a byte order mark, then the codec of the system locale, then the common codecs
+	const QTextCodec* likelyCodecs[] = {QTextCodec::codecForUtfText(sample.windows().front(), nullptr), QTextCodec::codecForLocale()};
+	for (const QTextCodec* codec: likelyCodecs)
+	{
+		const auto it = std::find_if(insertionPoint, codecs.end(), [codec](const CCodecRegistry::Codec* candidate) {return candidate->codec == codec;});
+		if (codec && it != codecs.end())
+			insertionPoint = std::rotate(insertionPoint, it, it + 1);
+	}
+
+	return codecs;
+}
+
+void CTextEncodingDetector::LeadingMatches::add(const std::vector<EncodingDetectionResult>& matches)
+{
+	// Same as leadsRunnerUp(): the matches tied exactly with the best one don't count as the runner-up
+	for (const auto& match: matches)
+	{
+		if (match.match > best)
+		{
+			runnerUp = best;
+			best = match.match;
+		}
+		else if (match.match < best && match.match > runnerUp)
+			runnerUp = match.match;
+	}
+}
+
+bool CTextEncodingDetector::isDecisive(const LeadingMatches& leadingMatches) const
+{
+	if (_options.earlyExitMatch <= 0.0f || leadingMatches.best < _options.earlyExitMatch)
+		return false;
+
+	// No runner-up yet is a lead by any margin
+	return leadingMatches.runnerUp == std::numeric_limits<float>::lowest() || leadingMatches.best - leadingMatches.runnerUp >= _options.earlyExitMargin * leadingMatches.best;
+}
+
+std::vector<CTextEncodingDetector::EncodingDetectionResult> CTextEncodingDetector::detectImpl(const CTextSample& sample) const
+{
+	// Like the batch workers, the calls reuse the parsers instead of reallocating their tables for each input
+	auto buffers = _parsingBuffersPool->acquire();
+	auto results = detectImpl(sample, *buffers, _options.threadPool != nullptr);
+	_parsingBuffersPool->release(std::move(buffers));
+	return results;
+}
+
+std::vector<CTextEncodingDetector::EncodingDetectionResult> CTextEncodingDetector::detectImpl(const CTextSample& sample, ParsingBuffers& buffers, const bool inParallel) const
+{
+	const CCodecRegistry::Codec* likelyCodec = nullptr;
+	if (_options.preClassify)
+	{
+		auto preClassified = preClassify(sample, buffers.parser, likelyCodec);
+		if (!preClassified.empty())
+			return preClassified;
+	}
+
+	return scoreAdaptively(sample, [this, likelyCodec, &buffers, inParallel](const CTextSample& roundSample) {
+		return inParallel ? scoreCodecsInParallel(roundSample, likelyCodec, buffers) : scoreCodecs(roundSample, likelyCodec, buffers);
+	});
+}
+
+template <typename ScoreFunction>
+std::vector<CTextEncodingDetector::EncodingDetectionResult> CTextEncodingDetector::scoreAdaptively(const CTextSample& sample, ScoreFunction&& scoreFunction) const
+{
+	if (_options.adaptiveSamplingInitialSize > 0)
+	{
+		// Every round scores a sample twice as large as the previous one from scratch, so the total work is at most twice the final round
+		const qint64 sampleSize = sample.size();
+		for (qint64 roundSize = _options.adaptiveSamplingInitialSize; roundSize < sampleSize; roundSize *= 2)
+		{
+			auto matches = scoreFunction(sample.truncated(roundSize));
+			if (isConfident(matches))
+				return matches;
+		}
+	}
+
+	return scoreFunction(sample);
+}
+
+bool CTextEncodingDetector::isPlausible(const EncodingDetectionResult& match) const
+{
+	return match.encodingIsCertain || match.match > _matchFunction->plausibleMatchThreshold();
+}
+
+bool CTextEncodingDetector::isConfident(const std::vector<EncodingDetectionResult>& matches) const
+{
+	return !matches.empty() && isPlausible(matches.front()) && leadsRunnerUp(matches, _options.adaptiveSamplingConfidenceGap);
+}
+
+std::vector<CTextEncodingDetector::EncodingDetectionResult> CTextEncodingDetector::scoreCodecsInParallel(const CTextSample& sample, const CCodecRegistry::Codec* likelyCodec, ParsingBuffers& buffers) const
+{
+	const auto& codecs = candidateCodecs(sample, likelyCodec, buffers.orderedCandidates);
+
+	// Each codec writes into its own slot, and the slots are merged in the codec order, so the result doesn't depend on the scheduling.
+	// The early exit is checked for every prefix of the codec list as soon as all of its codecs have been scored, same as the serial scoring does,
+	// so it stops at the same codec regardless of the order in which the workers finish.
+	std::vector<std::vector<EncodingDetectionResult>> matchesPerCodec(codecs.size());
+	std::vector<bool> codecScored(codecs.size(), false);
+	size_t numCodecsScoredInOrder = 0, numCodecsUsed = codecs.size();
+	LeadingMatches leadingMatches;
+	std::mutex mutex;
+	runOnWorkers<CTextParser>(codecs.size(), _options.threadPool, [&](const size_t codecIndex, CTextParser& parser) {
+		auto codecMatches = scoreCodec(sample, *codecs[codecIndex], parser);
+
+		std::lock_guard<std::mutex> lock(mutex);
+		matchesPerCodec[codecIndex] = std::move(codecMatches);
+		codecScored[codecIndex] = true;
+		while (numCodecsScoredInOrder < numCodecsUsed && codecScored[numCodecsScoredInOrder])
+		{
+			leadingMatches.add(matchesPerCodec[numCodecsScoredInOrder++]);
+			if (isDecisive(leadingMatches))
+				numCodecsUsed = numCodecsScoredInOrder;
+		}
+
+		return numCodecsScoredInOrder < numCodecsUsed;
+	});
 
-CTextEncodingDetector::DecodedText CTextEncodingDetector::decode(const QString & textFilePath, const std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>& tablesForLanguages)
+	// The codecs past the stopping point may have been scored by the other workers in the meantime
+	matchesPerCodec.resize(numCodecsUsed);
+	return mergeMatches(matchesPerCodec);
+}
+
+std::vector<CTextEncodingDetector::EncodingDetectionResult> CTextEncodingDetector::scoreCodecs(const CTextSample& sample, const CCodecRegistry::Codec* likelyCodec, ParsingBuffers& buffers) const
 {
-	const auto detectionResult = detect(textFilePath, tablesForLanguages);
-	if (!detectionResult.empty() && detectionResult.front().match > plausibleMatchThreshold)
+	const auto& codecs = candidateCodecs(sample, likelyCodec, buffers.orderedCandidates);
+
+	// Without the early exit, all the single-byte codecs are scored anyway, so the sample is walked once for all of them instead of once per codec.
+	// The fast decide mode scores the codecs one by one to stop at the first decisive one.
+	const CSingleByteCodecSet& singleByteCodecSet = CCodecRegistry::instance().singleByteCodecSet();
+	const bool singlePass = _options.earlyExitMatch <= 0.0f && !singleByteCodecSet.empty();
+	std::vector<bool> parsedBySingleByteCodec;
+	if (singlePass)
 	{
-		QTextCodec * codec = QTextCodec::codecForName(detectionResult.front().encoding.toUtf8().data());
-		assert_r(codec);
-		if (codec)
+		// Each codec only sees a fraction of the distinct trigrams, so the tables start small and grow on demand
+		while (buffers.singleByteCodecParsers.size() < singleByteCodecSet.size())
+			buffers.singleByteCodecParsers.emplace_back(1024);
+
+		for (auto& parser: buffers.singleByteCodecParsers)
+			parser.clear();
+
+		parsedBySingleByteCodec = CTextParser::parse(sample, singleByteCodecSet, buffers.singleByteCodecParsers);
+	}
+
+	std::vector<std::vector<EncodingDetectionResult>> matchesPerCodec(codecs.size());
+	LeadingMatches leadingMatches;
+	for (size_t i = 0; i < codecs.size(); ++i)
+	{
+		const CCodecRegistry::Codec& candidate = *codecs[i];
+		if (singlePass && candidate.singleByteTable)
 		{
-			QFile file(textFilePath);
-			file.open(QIODevice::ReadOnly);
-			return DecodedText{codec->toUnicode(file.readAll()), detectionResult.front().encoding, detectionResult.front().language};
+			if (parsedBySingleByteCodec[candidate.singleByteCodecSetIndex])
+				matchesPerCodec[i] = matchLanguages(candidate, buffers.singleByteCodecParsers[candidate.singleByteCodecSetIndex].parsingResult());
 		}
+		else
+			matchesPerCodec[i] = scoreCodec(sample, candidate, buffers.parser);
+
+		leadingMatches.add(matchesPerCodec[i]);
+		if (isDecisive(leadingMatches))
+			break;
 	}
 
-	return DecodedText();
+	return mergeMatches(matchesPerCodec);
+}
+
+std::vector<CTextEncodingDetector::EncodingDetectionResult> CTextEncodingDetector::scoreCodec(const CTextSample& sample, const CCodecRegistry::Codec& codec, CTextParser& parser) const
+{
+	parser.clear();
+	// Single-byte codecs are scored straight from the bytes, without decoding the sample
+	if (!(codec.singleByteTable ? parser.parse(sample, *codec.singleByteTable) : parser.parse(sample, *codec.codec)))
+		return {};
+
+	return matchLanguages(codec, parser.parsingResult());
+}
+
+std::vector<CTextEncodingDetector::EncodingDetectionResult> CTextEncodingDetector::matchLanguages(const CCodecRegistry::Codec& codec, const CTextParser::OccurrenceTable& occurrences) const
+{
+	const std::vector<float> matches = _matchFunction->match(occurrences);
+
+	std::vector<EncodingDetectionResult> match;
+	for (size_t i = 0; i < _tablesForLanguages.size(); ++i)
+		match.emplace_back(EncodingDetectionResult{ codec.name, _tablesForLanguages[i]->language(), matches[i], false, codec.codec });
+
+	return match;
+}
+
+std::vector<CTextEncodingDetector::EncodingDetectionResult> CTextEncodingDetector::mergeMatches(std::vector<std::vector<EncodingDetectionResult>>& matchesPerCodec)
+{
+	std::vector<EncodingDetectionResult> match;
+	for (auto& codecMatches: matchesPerCodec)
+		std::move(codecMatches.begin(), codecMatches.end(), std::back_inserter(match));
+
+	std::stable_sort(match.begin(), match.end(), [](const EncodingDetectionResult& l, const EncodingDetectionResult& r){return l.match > r.match;});
+	return match;
 }
 
-CTextEncodingDetector::DecodedText CTextEncodingDetector::decode(const QByteArray & textData, const std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>& tablesForLanguages)
+CTextEncodingDetector::DecodedText CTextEncodingDetector::decode(const QString & textFilePath) const
 {
-	const auto detectionResult = detect(textData, tablesForLanguages);
-	if (!detectionResult.empty() && detectionResult.front().match > plausibleMatchThreshold)
+	QString text;
+	DecodedText result = decode(textFilePath, text);
+	result.text = std::move(text);
+	return result;
+}
+
+CTextEncodingDetector::DecodedText CTextEncodingDetector::decode(const QByteArray & textData) const
+{
+	QString text;
+	DecodedText result = decode(textData, text);
+	result.text = std::move(text);
+	return result;
+}
+
+CTextEncodingDetector::DecodedText CTextEncodingDetector::decode(QIODevice & textDevice) const
+{
+	QString text;
+	DecodedText result = decode(textDevice, text);
+	result.text = std::move(text);
+	return result;
+}
+
+CTextEncodingDetector::DecodedText CTextEncodingDetector::decode(const QString& textFilePath, QString& text) const
+{
+	QFile file(textFilePath);
+	if (!file.open(QIODevice::ReadOnly))
+		return DecodedText();
+
+	// Both the detection and the final conversion read straight from the mapping
+	const QByteArray mappedData = mapFile(file);
+	if (!mappedData.isEmpty())
+		return decode(mappedData, text);
+	else if (file.size() <= maxByteArraySize)
+		return decode(file, text);
+
+	// Too large to be read into a single QByteArray: converted chunk by chunk straight into the string
+	text.clear();
+	const auto reader = decodeStreaming(file, nullptr, CDecodingReader::defaultChunkSize);
+	if (!reader)
+		return DecodedText();
+
+	const bool complete = reader->readAll([&text](const QString& chunk) {
+		// The text of such a large input may not fit into a QString either
+		if (text.size() > maxStringSize - chunk.size())
+			return false;
+
+		text += chunk;
+		return true;
+	});
+
+	if (!complete)
 	{
-		QTextCodec * codec = QTextCodec::codecForName(detectionResult.front().encoding.toUtf8().data());
-		assert_r(codec);
-		if (codec)
-			return DecodedText{codec->toUnicode(textData), detectionResult.front().encoding, detectionResult.front().language};
+		text.clear();
+		return DecodedText();
 	}
 
-	return DecodedText();
+	return DecodedText{QString(), reader->encoding(), reader->language()};
 }
 
-CTextEncodingDetector::DecodedText CTextEncodingDetector::decode(QIODevice & textDevice, const std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>& tablesForLanguages)
+CTextEncodingDetector::DecodedText CTextEncodingDetector::decode(const QByteArray& textData, QString& text) const
 {
-	const auto detectionResult = detect(textDevice, tablesForLanguages);
-	if (!detectionResult.empty() && detectionResult.front().match > plausibleMatchThreshold)
+	text.clear();
+
+	const auto detectionResult = detect(textData);
+	if (detectionResult.empty() || !isPlausible(detectionResult.front()))
+		return DecodedText();
+
+	const QTextCodec* codec = detectionResult.front().codec;
+	if (!assert_r(codec))
+		return DecodedText();
+
+	// Converts into the existing buffer of the string where the codec supports it (UTF-8, Latin-1)
+	QTextDecoder decoder(codec);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+	// QTextDecoder takes int lengths, so larger inputs are converted in pieces; the decoder carries a character split between two pieces over to the next one
+	const qint64 size = textData.size();
+	if (size > maxDecoderPieceSize)
 	{
-		QTextCodec * codec = QTextCodec::codecForName(detectionResult.front().encoding.toUtf8().data());
-		assert_r(codec);
-		if (codec)
-			return DecodedText{codec->toUnicode(textDevice.readAll()), detectionResult.front().encoding, detectionResult.front().language};
+		for (qint64 offset = 0; offset < size; offset += maxDecoderPieceSize)
+			text += decoder.toUnicode(textData.constData() + offset, (int)std::min(maxDecoderPieceSize, size - offset));
 	}
+	else
+#endif
+		decoder.toUnicode(&text, textData.constData(), (int)textData.size());
+
+	// A multibyte sequence truncated by the end of the input is still held by the decoder; QTextCodec::toUnicode() emits a replacement character for it, and so does this
+	if (decoder.needsMoreData())
+		text += QChar(QChar::ReplacementCharacter);
+	return DecodedText{QString(), detectionResult.front().encoding, detectionResult.front().language};
+}
 
-	return DecodedText();
+CTextEncodingDetector::DecodedText CTextEncodingDetector::decode(QIODevice& textDevice, QString& text) const
+{
+	// The whole input is needed for the conversion anyway, so it is read once and the detection samples the buffer.
+	// Sampling the device first would consume the prefix of a sequential device, and read the windows twice from a random-access one.
+	return decode(readToEnd(textDevice), text);
+}
+
+std::unique_ptr<CDecodingReader> CTextEncodingDetector::decodeStreaming(const QString& textFilePath, qint64 chunkSize) const
+{
+	auto file = std::make_unique<QFile>(textFilePath);
+	if (!file->open(QIODevice::ReadOnly))
+		return nullptr;
+
+	QFile& fileRef = *file;
+	return decodeStreaming(fileRef, std::move(file), chunkSize);
+}
+
+std::unique_ptr<CDecodingReader> CTextEncodingDetector::decodeStreaming(QIODevice& textDevice, qint64 chunkSize) const
+{
+	return decodeStreaming(textDevice, nullptr, chunkSize);
+}
+
+std::unique_ptr<CDecodingReader> CTextEncodingDetector::decodeStreaming(QIODevice& textDevice, std::unique_ptr<QIODevice> ownedDevice, qint64 chunkSize) const
+{
+	// Random-access devices are sampled without moving the current position; a sequential device is sampled by reading its prefix, which is then handed to the reader
+	const auto sample = CTextSample::fromDevice(textDevice, _options.sampling);
+	const auto detectionResult = detectImpl(sample);
+	if (detectionResult.empty() || !isPlausible(detectionResult.front()))
+		return nullptr;
+
+	const QTextCodec* codec = detectionResult.front().codec;
+	if (!assert_r(codec))
+		return nullptr;
+
+	QByteArray consumedPrefix = textDevice.isSequential() && !sample.isEmpty() ? sample.windows().front() : QByteArray();
+	auto reader = ownedDevice ?
+		std::make_unique<CDecodingReader>(std::move(ownedDevice), *codec, std::move(consumedPrefix), chunkSize) :
+		std::make_unique<CDecodingReader>(textDevice, *codec, std::move(consumedPrefix), chunkSize);
+	reader->setLanguage(detectionResult.front().language);
+	return reader;
+}
+
+std::vector<CTextEncodingDetector::EncodingDetectionResult> CTextEncodingDetector::detect(const QString & textFilePath) const
+{
+	return detectInFile(textFilePath, _options.sampling, [this](const CTextSample& sample) {
+		return detectImpl(sample);
+	});
+}
+
+std::vector<CTextEncodingDetector::EncodingDetectionResult> CTextEncodingDetector::detect(const QByteArray & textData) const
+{
+	return detectImpl(CTextSample::fromData(textData, _options.sampling));
 }
 
-std::vector<CTextEncodingDetector::EncodingDetectionResult> CTextEncodingDetector::detect(const QString & textFilePath, const std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>& tablesForLanguages)
+std::vector<CTextEncodingDetector::EncodingDetectionResult> CTextEncodingDetector::detect(QIODevice & textDevice) const
 {
-	return ::detect(textFilePath, tablesForLanguages);
+	return detectImpl(CTextSample::fromDevice(textDevice, _options.sampling));
 }
 
-std::vector<CTextEncodingDetector::EncodingDetectionResult> CTextEncodingDetector::detect(const QByteArray & textData, const std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>& tablesForLanguages)
+void CTextEncodingDetector::detectBatch(const QStringList& textFilePaths, const BatchResultCallback& onResult) const
 {
-	return ::detect(textData, tablesForLanguages);
+	runOnWorkers<ParsingBuffers>((size_t)textFilePaths.size(), _options.threadPool ? _options.threadPool : QThreadPool::globalInstance(), [&](const size_t fileIndex, ParsingBuffers& buffers) {
+		onResult(fileIndex, detectInFile(textFilePaths[(qsizetype)fileIndex], _options.sampling, [&](const CTextSample& sample) {
+			return detectImpl(sample, buffers, false);
+		}));
+		return true;
+	});
 }
 
-std::vector<CTextEncodingDetector::EncodingDetectionResult> CTextEncodingDetector::detect(QIODevice & textDevice, const std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>& tablesForLanguages)
+void CTextEncodingDetector::detectBatch(const std::vector<QByteArray>& textDataItems, const BatchResultCallback& onResult) const
 {
-	return ::detect(textDevice, tablesForLanguages);
+	runOnWorkers<ParsingBuffers>(textDataItems.size(), _options.threadPool ? _options.threadPool : QThreadPool::globalInstance(), [&](const size_t itemIndex, ParsingBuffers& buffers) {
+		onResult(itemIndex, detectImpl(CTextSample::fromData(textDataItems[itemIndex], _options.sampling), buffers, false));
+		return true;
+	});
 }
@@ -1,14 +1,30 @@
 #pragma once
 
+#include "ccodecregistry.h"
+#include "cdecodingreader.h"
+#include "ctextsample.h"
+#include "matchfunctions/cmatchfunction_base.h"
 #include "trigramfrequencytables/ctrigramfrequencytable_base.h"
 
+DISABLE_COMPILER_WARNINGS
+#include <QStringList>
+RESTORE_COMPILER_WARNINGS
+
+#include <functional>
+#include <limits>
 #include <memory>
 #include <vector>
 
 class CTrigramFrequencyTable_Base;
 class QIODevice;
 class QByteArray;
+class CTextParser;
+class QTextCodec;
+class QThreadPool;
 
+// The language tables are set up once, when the detector is constructed; the candidate codecs come from the process-wide CCodecRegistry.
+// The detector is immutable afterwards: all the detect() and decode() overloads are const and may be called concurrently from any number of threads.
+// The only state they share is a pool of parsing buffers, which a call takes for its duration under a short lock.
 class CTextEncodingDetector
 {
 public:
@@ -23,23 +39,140 @@ public:
 		QString encoding;
 		QString language;
 		float match; // 0.0 to 1.0
+		// The encoding was recognized by the byte-level pre-pass from a byte order mark, or from pure ASCII or valid UTF-8 over the whole input; match only ranks the languages then.
+		// An ASCII or UTF-8 verdict on a sample of a larger input is not conclusive: UTF-8 is scored along with the other codecs, ahead of them, so it wins the ties.
+		bool encodingIsCertain = false;
+		const QTextCodec* codec = nullptr; // The codec of the encoding, ready to use for the conversion
+	};
+
+	// Creates the function that scores the samples against the language tables
+	using MatchFunctionFactory = std::function<std::unique_ptr<CMatchFunction_Base> (const std::vector<const CTrigramFrequencyTable_Base*>& tables)>;
+
+	struct Options
+	{
+		// Only this many bytes of the input are decoded and analyzed per codec
+		CTextSample::Parameters sampling;
+		// If set, the candidate codecs are scored in parallel on this pool (e.g. QThreadPool::globalInstance()) as well as on the calling thread.
+		// The results are identical to the serial ones.
+		QThreadPool* threadPool = nullptr;
+		// Fast decide mode: if greater than 0, the codecs are scored in the order of their prior likelihood (byte order mark, system locale, common encodings),
+		// and the scoring stops as soon as the best match so far reaches earlyExitMatch and leads the runner-up among all the candidates scored so far
+		// by at least earlyExitMargin (relative to the best match). The codecs that were not scored are then missing from the detect() results.
+		// The stopping point only depends on the scores, not on the scheduling: with threadPool, it is decided on the codecs in order,
+		// and the results of the codecs past it are discarded, so the results are identical to the serial ones.
+		// decode() only uses the best candidate, so it benefits the most. 0 (the default) disables the early exit.
+		float earlyExitMatch = 0.0f;
+		float earlyExitMargin = 0.25f;
+		// Adaptive sampling: if greater than 0, the sample is first scored on its first this many bytes (spread over all the windows), and the amount is doubled
+		// every round until the best match leads the runner-up by at least adaptiveSamplingConfidenceGap (relative to the best match), or the whole sample has been scored.
+		// Unambiguous inputs are then decided after a few hundred bytes, while the hard ones still get the full sample. 0 (the default) always scores the whole sample.
+		// Only the scoring is adaptive, not the I/O: the whole sample is taken from the input before the first round. For a memory-mapped file that costs little,
+		// as only the pages of the windows are touched, but a device that can't be mapped has all the sampled windows read up front.
+		qint64 adaptiveSamplingInitialSize = 0;
+		float adaptiveSamplingConfidenceGap = 0.25f;
+		// Byte-level pre-pass: inputs with a byte order mark, pure 7-bit ASCII and valid UTF-8 inputs are recognized without scoring the codecs.
+		// If only a sample of the input was checked, the codecs are scored anyway, UTF-8 first.
+		bool preClassify = true;
+		// Whether the text recognized by the pre-pass is still scored against the language tables to determine its language
+		bool detectLanguageOfPreClassifiedText = true;
+		// CMatchFunction_L1 if not set
+		MatchFunctionFactory matchFunction;
 	};
 
-	[[nodiscard]] static DecodedText
-	decode(const QString& textFilePath, const std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>& tablesForLanguages = std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>());
-	[[nodiscard]] static DecodedText
-	decode(const QByteArray& textData, const std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>& tablesForLanguages = std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>());
-	[[nodiscard]] static DecodedText
-	decode(QIODevice& textDevice, const std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>& tablesForLanguages = std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>());
+	// If no tables are supplied, the default ones (English and Russian) are used
+	explicit CTextEncodingDetector(std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>> tablesForLanguages = {});
+	CTextEncodingDetector(const Options& options, std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>> tablesForLanguages = {});
+	CTextEncodingDetector(CTextEncodingDetector&&) noexcept;
+	CTextEncodingDetector& operator=(CTextEncodingDetector&&) noexcept;
+	~CTextEncodingDetector();
+
+	[[nodiscard]] DecodedText decode(const QString& textFilePath) const;
+	[[nodiscard]] DecodedText decode(const QByteArray& textData) const;
+	[[nodiscard]] DecodedText decode(QIODevice& textDevice) const;
 
+	// Same as above, but the text is converted into the supplied string, reusing its buffer where the codec allows it; DecodedText::text is left empty.
+	// The input is converted exactly once, from the same bytes the detection has sampled: a file is memory-mapped, a device is read through once.
+	// A file too large for a QByteArray (2 GB with Qt 5) is converted chunk by chunk instead; if its text doesn't fit into a QString either, the result is empty.
+	DecodedText decode(const QString& textFilePath, QString& text) const;
+	DecodedText decode(const QByteArray& textData, QString& text) const;
+	DecodedText decode(QIODevice& textDevice, QString& text) const;
+
+	// Streaming decoding for the inputs too large to be held as a single QString: the encoding is detected from the bounded sample (Options::sampling),
+	// and the returned reader converts the input chunk by chunk. Returns nullptr if no plausible encoding was found.
+	// The device is read from its current position and must outlive the reader; the file is owned by the reader.
+	[[nodiscard]] std::unique_ptr<CDecodingReader> decodeStreaming(const QString& textFilePath, qint64 chunkSize = CDecodingReader::defaultChunkSize) const;
+	[[nodiscard]] std::unique_ptr<CDecodingReader> decodeStreaming(QIODevice& textDevice, qint64 chunkSize = CDecodingReader::defaultChunkSize) const;
 
 	// The results are sorted by match from high to low
-	[[nodiscard]] static std::vector<EncodingDetectionResult>
-	detect(const QString& textFilePath, const std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>& tablesForLanguages = std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>());
+	[[nodiscard]] std::vector<EncodingDetectionResult> detect(const QString& textFilePath) const;
+	[[nodiscard]] std::vector<EncodingDetectionResult> detect(const QByteArray& textData) const;
+	[[nodiscard]] std::vector<EncodingDetectionResult> detect(QIODevice& textDevice) const;
+
+	// Called on a worker thread as soon as the input with the given index has been processed, so it must be thread-safe
+	using BatchResultCallback = std::function<void (size_t inputIndex, std::vector<EncodingDetectionResult>&& results)>;
+
+	// Processes many inputs on the calling thread and on the idle threads of Options::threadPool (QThreadPool::globalInstance() if not set).
+	// The inputs are distributed dynamically, and every thread reuses its parsing buffers for all the inputs it takes; each single input is scored serially.
+	// Returns when all the inputs have been processed.
+	void detectBatch(const QStringList& textFilePaths, const BatchResultCallback& onResult) const;
+	void detectBatch(const std::vector<QByteArray>& textDataItems, const BatchResultCallback& onResult) const;
+
+private:
+	// Scores the codecs in parallel if Options::threadPool is set
+	[[nodiscard]] std::vector<EncodingDetectionResult> detectImpl(const CTextSample& sample) const;
+	// Per-thread parsing state, reused for all the inputs the thread processes
+	struct ParsingBuffers
+	{
+		CTextParser parser;
+		std::vector<CTextParser> singleByteCodecParsers; // One per codec of CCodecRegistry::singleByteCodecSet()
+		std::vector<const CCodecRegistry::Codec*> orderedCandidates; // See candidateCodecs()
+	};
+
+	// The buffers of the detect() calls, reused by the consecutive calls; see the .cpp
+	class ParsingBuffersPool;
+
+	// Reuses the supplied buffers; scores the codecs on Options::threadPool if inParallel is set, serially otherwise
+	[[nodiscard]] std::vector<EncodingDetectionResult> detectImpl(const CTextSample& sample, ParsingBuffers& buffers, bool inParallel) const;
+
+	// Implements Options::adaptiveSamplingInitialSize; scoreFunction(const CTextSample&) scores all the candidate codecs
+	template <typename ScoreFunction>
+	[[nodiscard]] std::vector<EncodingDetectionResult> scoreAdaptively(const CTextSample& sample, ScoreFunction&& scoreFunction) const;
+	[[nodiscard]] bool isConfident(const std::vector<EncodingDetectionResult>& matches) const;
+	// Whether the result is certain or its match exceeds the plausibility threshold of the match function
+	[[nodiscard]] bool isPlausible(const EncodingDetectionResult& match) const;
+
+	// likelyCodec, if not nullptr, is scored ahead of the candidate codecs
+	[[nodiscard]] std::vector<EncodingDetectionResult> scoreCodecsInParallel(const CTextSample& sample, const CCodecRegistry::Codec* likelyCodec, ParsingBuffers& buffers) const;
+	[[nodiscard]] std::vector<EncodingDetectionResult> scoreCodecs(const CTextSample& sample, const CCodecRegistry::Codec* likelyCodec, ParsingBuffers& buffers) const;
+
+	// ownedDevice is either nullptr or the owner of textDevice, to be handed over to the reader
+	[[nodiscard]] std::unique_ptr<CDecodingReader> decodeStreaming(QIODevice& textDevice, std::unique_ptr<QIODevice> ownedDevice, qint64 chunkSize) const;
+
+	// Returns an empty vector unless the pre-pass has determined the encoding for certain.
+	// An ASCII or UTF-8 verdict on a sample of a larger input only sets likelyCodec, to be scored first; it's nullptr if there is no verdict.
+	[[nodiscard]] std::vector<EncodingDetectionResult> preClassify(const CTextSample& sample, CTextParser& parser, const CCodecRegistry::Codec*& likelyCodec) const;
+	// likelyCodec first, if any; the rest in the order of the prior likelihood if Options::earlyExitMatch is set, otherwise in the fixed default order.
+	// Returns CCodecRegistry::candidates() itself unless they have to be reordered, which is done in orderedCandidates (reusing its buffer).
+	[[nodiscard]] const std::vector<const CCodecRegistry::Codec*>& candidateCodecs(const CTextSample& sample, const CCodecRegistry::Codec* likelyCodec, std::vector<const CCodecRegistry::Codec*>& orderedCandidates) const;
+	// The best match of the codecs scored so far and the runner-up, the highest match below it; updated as the matches of every codec come in
+	struct LeadingMatches
+	{
+		float best = std::numeric_limits<float>::lowest();
+		float runnerUp = std::numeric_limits<float>::lowest();
+
+		void add(const std::vector<EncodingDetectionResult>& matches);
+	};
+
+	// Implements Options::earlyExitMatch: whether the scoring can stop at the codecs scored so far
+	[[nodiscard]] bool isDecisive(const LeadingMatches& leadingMatches) const;
 
-	[[nodiscard]] static std::vector<EncodingDetectionResult>
-	detect(const QByteArray& textData, const std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>& tablesForLanguages = std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>());
+	[[nodiscard]] std::vector<EncodingDetectionResult> scoreCodec(const CTextSample& sample, const CCodecRegistry::Codec& codec, CTextParser& parser) const;
+	[[nodiscard]] std::vector<EncodingDetectionResult> matchLanguages(const CCodecRegistry::Codec& codec, const CTextParser::OccurrenceTable& occurrences) const;
+	[[nodiscard]] static std::vector<EncodingDetectionResult> mergeMatches(std::vector<std::vector<EncodingDetectionResult>>& matchesPerCodec);
 
-	[[nodiscard]] static std::vector<EncodingDetectionResult>
-	detect(QIODevice& textDevice, const std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>& tablesForLanguages = std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>>());
+private:
+	Options _options;
+	std::vector<std::unique_ptr<CTrigramFrequencyTable_Base>> _tablesForLanguages;
+	std::unique_ptr<const CMatchFunction_Base> _matchFunction;
+	std::unique_ptr<ParsingBuffersPool> _parsingBuffersPool;
 };
@@ -1,91 +1,193 @@
 #include "ctextparser.h"
+#include "ccharactertokenizer.h"
+#include "csinglebytecodectable.h"
 #include "assert/advanced_assert.h"
 
 DISABLE_COMPILER_WARNINGS
 #include <QFile>
 #include <QTextCodec>
-#include <QTextStream>
 RESTORE_COMPILER_WARNINGS
 
+#include <algorithm>
+#include <array>
+
+// The budget of the parse() overloads that take the whole input: this many characters (not bytes), in the default number of evenly spaced windows
+static constexpr qint64 numCharactersToAnalyze = 10000;
+// UTF-32; no other codec takes more bytes per character
+static constexpr qint64 maxBytesPerCharacter = 4;
+
+static CTextSample::Parameters characterSampling()
+{
+	CTextSample::Parameters parameters;
+	parameters.sampleSize = numCharactersToAnalyze * maxBytesPerCharacter;
+	return parameters;
+}
+
+CTextParser::CTextParser(size_t expectedNumberOfTrigrams) :
+	_parsingResult{CTrigramCountTable(expectedNumberOfTrigrams), 0}
+{
+}
+
 bool CTextParser::parse(const QString & textFilePath, const QString& codecName)
 {
 	QFile file(textFilePath);
-	if (!file.exists())
+	if (!file.open(QIODevice::ReadOnly))
 		return false;
 
-	// TODO: avoid reading the whole file. Currently (as of Qt 5.13.2) not easily doable due to bugs in QBuffer (seek(), bytesAvailable() behave in a weird way).
-	return parse(file.readAll(), codecName);
+	return parse(file, codecName);
 }
 
 bool CTextParser::parse(QIODevice& textDevice, const QString& codecName)
 {
-	// TODO: avoid reading the whole file. Currently (as of Qt 5.13.2) not easily doable due to bugs in QBuffer (seek(), bytesAvailable() behave in a weird way).
-	return parse(textDevice.readAll(), codecName);
+	const QTextCodec* codec = QTextCodec::codecForName(codecName.toUtf8());
+	if (!assert_r(codec))
+		return false;
+
+	return parseCharacterSample(CTextSample::fromDevice(textDevice, characterSampling()), *codec);
 }
 
 bool CTextParser::parse(const QByteArray& textData, const QString& codecName)
 {
 	assert_r(!codecName.isEmpty());
 
-	QTextCodec* codec = QTextCodec::codecForName(codecName.toUtf8());
-	auto* decoder = codec->makeDecoder();
-	QString decodedText = decoder->toUnicode(textData);
-	QTextStream stream(&decodedText, QIODevice::ReadOnly);
+	const QTextCodec* codec = QTextCodec::codecForName(codecName.toUtf8());
+	if (!assert_r(codec))
+		return false;
+
+	return parseCharacterSample(CTextSample::fromData(textData, characterSampling()), *codec);
+}
+
+bool CTextParser::parseCharacterSample(const CTextSample& sample, const QTextCodec& codec)
+{
+	if (sample.isEmpty())
+		return false;
+
+	// The sample is large enough for the widest codec. The number of bytes per character in this one is estimated from the first window,
+	// and the other windows are cut down to the bytes that hold their share of numCharactersToAnalyze characters before they are decoded, so every byte is decoded at most once.
+	QTextCodec::ConverterState converterState;
+	const QByteArray& firstWindow = sample.windows().front();
+	const QString firstWindowText = codec.toUnicode(firstWindow.constData(), (int)firstWindow.size(), &converterState);
+	const qint64 numBytesToAnalyze = numCharactersToAnalyze * firstWindow.size() / std::max<qint64>(firstWindowText.size(), 1);
+	const CTextSample truncatedSample = sample.truncated(numBytesToAnalyze);
+
+	TrigramState state;
+	const auto& windows = truncatedSample.windows();
+	parseText(state, QStringView(firstWindowText).left((qsizetype)((qint64)firstWindowText.size() * windows.front().size() / firstWindow.size())));
+	for (size_t i = 1; i < windows.size(); ++i)
+	{
+		const QString decodedText = codec.toUnicode(windows[i].constData(), (int)windows[i].size(), &converterState);
+		parseText(state, decodedText);
+	}
+
+	return state.numLettersRead == 3;
+}
+
+bool CTextParser::parse(const CTextSample& sample, const QTextCodec& codec)
+{
+	TrigramState state;
+	// Shared by all the windows, so that the byte order detected from a UTF-16 or UTF-32 byte order mark in the first window applies to the rest.
+	// A window may start in the middle of a multibyte sequence, so its first character can be garbage. This only affects a couple of trigrams.
+	QTextCodec::ConverterState converterState;
+	for (const QByteArray& window: sample.windows())
+	{
+		const QString decodedText = codec.toUnicode(window.constData(), (int)window.size(), &converterState);
+		parseText(state, decodedText);
+	}
+
+	return state.numLettersRead == 3;
+}
+
+bool CTextParser::parse(QStringView text)
+{
+	TrigramState state;
+	return parse(text, state);
+}
+
+bool CTextParser::parse(QStringView text, TrigramState& state)
+{
+	parseText(state, text);
+	return state.numLettersRead == 3;
+}
+
+void CTextParser::parseText(TrigramState& state, QStringView text)
+{
+	// The text is classified and lowercased in blocks small enough for the buffers to stay in the L1 cache; the tokenizer is vectorized for the common Latin and Cyrillic text
+	constexpr size_t blockSize = 1024;
+	std::array<char16_t, blockSize> lowercase;
+	std::array<quint8, blockSize> characterClasses;
 
-	// Read the first 3 symbols
-	QString currentTrigram;
-	QChar ch;
-	for (int i = 0; i < 3;)
+	const auto* characters = reinterpret_cast<const char16_t*>(text.utf16());
+	for (size_t blockStart = 0, length = (size_t)text.size(); blockStart < length; blockStart += blockSize)
 	{
-		if (stream.atEnd())
-			return false;
+		const size_t currentBlockSize = std::min(blockSize, length - blockStart);
+		CCharacterTokenizer::tokenize(characters + blockStart, currentBlockSize, lowercase.data(), characterClasses.data());
 
-		stream >> ch;
-		if (ch.isLetter())
+		for (size_t i = 0; i < currentBlockSize; ++i)
 		{
-			ch = ch.toLower();
-			currentTrigram.append(ch);
-			++i;
+			// Whitespace is skipped, same as by QTextStream::operator>>(QChar&)
+			const quint8 characterClass = characterClasses[i];
+			if ((characterClass & CCharacterTokenizer::Space) == 0)
+				addCharacter(state, lowercase[i], (characterClass & CCharacterTokenizer::Letter) != 0);
 		}
 	}
+}
 
-	assert_r(currentTrigram.length() == 3);
-	++_parsingResult.trigramOccurrenceTable[currentTrigram];
-	++_parsingResult.totalTrigramsCount;
+bool CTextParser::parse(const CTextSample& sample, const CSingleByteCodecTable& codecTable)
+{
+	TrigramState state;
+	for (const QByteArray& window: sample.windows())
+	{
+		const auto* bytes = reinterpret_cast<const uchar*>(window.constData());
+		for (qsizetype i = 0, size = window.size(); i < size; ++i)
+		{
+			// Same as the whitespace skipping in QTextStream::operator>>(QChar&)
+			const uchar byte = bytes[i];
+			if (!codecTable.isSpace(byte))
+				addCharacter(state, codecTable.lowercase(byte), codecTable.isLetter(byte));
+		}
+	}
 
-	const qint64 numCharactersToAnalyze = 10000;
-	const qint64 numChunks = 10, chunkSize = numCharactersToAnalyze / numChunks;
-	static_assert(numCharactersToAnalyze > 0 && numChunks > 0, "Number of characters and number of chunks must be greater than 0");
+	return state.numLettersRead == 3;
+}
 
-	// Reading up to numCharactersToAnalyze characters, in numChunks x (numCharactersToAnalyze/numChunks) evenly spaced chunks
+std::vector<bool> CTextParser::parse(const CTextSample& sample, const CSingleByteCodecSet& codecSet, std::vector<CTextParser>& parsers)
+{
+	assert_r(parsers.size() == codecSet.size());
 
-	const qint64 stride = textData.size() <= numCharactersToAnalyze || numChunks == 0 ? 0 : (textData.size() - numCharactersToAnalyze) / (numChunks - 1);
-	qint64 charactersCounter = 0;
-	while (!stream.atEnd())
+	const size_t numCodecs = codecSet.size();
+	std::vector<TrigramState> states(numCodecs);
+	for (const QByteArray& window: sample.windows())
 	{
-		stream >> ch;
-		++charactersCounter;
-		if (charactersCounter > chunkSize)
+		const auto* bytes = reinterpret_cast<const uchar*>(window.constData());
+		for (qsizetype i = 0, size = window.size(); i < size; ++i)
 		{
-			//auto newPos = std::min(stream.pos() + stride, textData.size());
-			if (stream.seek(stream.pos() + stride))
+			const CSingleByteCodecSet::ByteClass* byteClasses = codecSet.row(bytes[i]);
+			for (size_t codec = 0; codec < numCodecs; ++codec)
 			{
-				charactersCounter = 0;
-				continue;
+				const CSingleByteCodecSet::ByteClass& byteClass = byteClasses[codec];
+				if (!byteClass.isSpace)
+					parsers[codec].addCharacter(states[codec], byteClass.lowercase, byteClass.isLetter);
 			}
-			else
-				break; // seek fails when we're trying to move past the end, which is our cue to stop
 		}
+	}
+
+	std::vector<bool> parsed(numCodecs);
+	for (size_t codec = 0; codec < numCodecs; ++codec)
+		parsed[codec] = states[codec].numLettersRead == 3;
 
-		currentTrigram.remove(0, 1);
-		currentTrigram.append(ch.toLower());
+	return parsed;
+}
 
+QString CTextParser::unpackTrigram(Trigram trigram)
+{
+	static constexpr Trigram codePointMask = (Trigram{1} << 21) - 1;
 
-		++_parsingResult.trigramOccurrenceTable[currentTrigram];
-		++_parsingResult.totalTrigramsCount;
-	}
+	QString result;
+	result.reserve(3);
+	for (const int shift: {42, 21, 0})
+		result.append(QChar(static_cast<char16_t>((trigram >> shift) & codePointMask)));
 
-	return true;
+	return result;
 }
 
 void CTextParser::clear()
@@ -1,34 +1,98 @@
 #pragma once
 
-#include "compiler/compiler_warnings_control.h"
+#include "ctextsample.h"
+#include "ctrigramcounttable.h"
 
 DISABLE_COMPILER_WARNINGS
-#include <QHash>
 #include <QString>
+#include <QStringView>
 RESTORE_COMPILER_WARNINGS
 
 class QByteArray;
 class QIODevice;
+class CSingleByteCodecSet;
+class CSingleByteCodecTable;
+class QTextCodec;
 
 class CTextParser
 {
 public:
+	explicit CTextParser(size_t expectedNumberOfTrigrams = 4096);
+
+	// A trigram packed into an integer: three 21-bit code points, the first character in the most significant bits
+	using Trigram = quint64;
+
+	[[nodiscard]] static constexpr Trigram packTrigram(char32_t first, char32_t second, char32_t third) noexcept {
+		return (Trigram{first} << 42) | (Trigram{second} << 21) | Trigram{third};
+	}
+
+	// Drops the first character of the trigram and appends the new one
+	[[nodiscard]] static constexpr Trigram shiftTrigram(Trigram trigram, char32_t nextCharacter) noexcept {
+		return ((trigram << 21) | Trigram{nextCharacter}) & ((Trigram{1} << 63) - 1);
+	}
+
+	[[nodiscard]] static QString unpackTrigram(Trigram trigram);
+
 	struct OccurrenceTable
 	{
-		QHash<QString /*trigraph*/, quint64 /*count*/> trigramOccurrenceTable;
+		CTrigramCountTable trigramOccurrenceTable;
 		quint64 totalTrigramsCount = 0;
 	};
 
-	// Subsequent calls to parse() will not reset the frequency table
+	// The trigram being assembled, carried across the sample windows or the consecutive pieces of a text
+	struct TrigramState
+	{
+		Trigram trigram = 0;
+		int numLettersRead = 0; // The first trigram must consist of 3 letters; from then on, any non-whitespace characters are counted
+	};
+
+	// Subsequent calls to parse() will not reset the frequency table.
+	// These three analyze about 10000 characters of the input in evenly spaced windows, however many bytes they take in the given codec.
 	bool parse(const QString& textFilePath, const QString& codecName);
 	bool parse(QIODevice& textDevice, const QString& codecName);
 	bool parse(const QByteArray& textData, const QString& codecName);
 
+	// Each window of the sample is decoded separately; the trigrams continue across the window boundaries
+	bool parse(const CTextSample& sample, const QTextCodec& codec);
+	// Produces the same result as the overload above for the corresponding codec, but scans the bytes directly instead of decoding them
+	bool parse(const CTextSample& sample, const CSingleByteCodecTable& codecTable);
+	// Text that has already been decoded
+	bool parse(QStringView text);
+	// The next piece of a text that is decoded incrementally: the trigrams continue from the state left by the previous piece.
+	// Returns true once the state holds a complete trigram.
+	bool parse(QStringView text, TrigramState& state);
+
+	// Single-pass scoring of many single-byte codecs: the sample is walked once, and every byte advances the trigrams of all the codecs in the set.
+	// parsers[i] gets the same result as parsers[i].parse(sample, <the table of codec i>) would produce; the return value holds what these calls would have returned.
+	static std::vector<bool> parse(const CTextSample& sample, const CSingleByteCodecSet& codecSet, std::vector<CTextParser>& parsers);
+
 	// This method clears the table and sets counters to 0
 	void clear();
 
 	[[nodiscard]] const OccurrenceTable& parsingResult() const;
 
+private:
+	// Analyzes about a fixed number of characters of the sample regardless of the number of bytes per character of the codec, as estimated from the first window
+	bool parseCharacterSample(const CTextSample& sample, const QTextCodec& codec);
+	void parseText(TrigramState& state, QStringView text);
+
+	inline void addCharacter(TrigramState& state, const char16_t lowercaseCharacter, const bool isLetter) {
+		if (state.numLettersRead < 3)
+		{
+			if (!isLetter)
+				return;
+
+			state.trigram = shiftTrigram(state.trigram, lowercaseCharacter);
+			if (++state.numLettersRead < 3)
+				return;
+		}
+		else
+			state.trigram = shiftTrigram(state.trigram, lowercaseCharacter);
+
+		_parsingResult.trigramOccurrenceTable.add(state.trigram);
+		++_parsingResult.totalTrigramsCount;
+	}
+
 private:
 	OccurrenceTable _parsingResult;
 };
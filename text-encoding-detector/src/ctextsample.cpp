@@ -0,0 +1,123 @@
+#include "ctextsample.h"
+#include "assert/advanced_assert.h"
+
+DISABLE_COMPILER_WARNINGS
+#include <QIODevice>
+RESTORE_COMPILER_WARNINGS
+
+#include <algorithm>
+
+CTextSample CTextSample::fromData(const QByteArray& textData, const Parameters& parameters)
+{
+	CTextSample sample;
+	if (textData.isEmpty())
+		return sample;
+
+	const qint64 size = windowSize(textData.size(), parameters);
+	sample._isComplete = size == textData.size();
+	for (const qint64 offset: windowOffsets(textData.size(), parameters))
+		sample._windows.push_back(sample._isComplete ? textData : QByteArray::fromRawData(textData.constData() + offset, size));
+
+	return sample;
+}
+
+CTextSample CTextSample::fromDevice(QIODevice& textDevice, const Parameters& parameters)
+{
+	CTextSample sample;
+	if (!textDevice.isReadable())
+		return sample;
+
+	if (textDevice.isSequential())
+	{
+		QByteArray prefix;
+		prefix.reserve(parameters.sampleSize);
+		while (prefix.size() < parameters.sampleSize)
+		{
+			const QByteArray chunk = textDevice.read(parameters.sampleSize - prefix.size());
+			if (!chunk.isEmpty())
+				prefix.append(chunk);
+			else if (!textDevice.waitForReadyRead(sequentialReadTimeoutMs))
+				break; // No more data, or the device has been idle for too long
+		}
+
+		// A prefix that ended before the sample size is the whole input (a device that has been idle for too long counts as ended)
+		sample._isComplete = prefix.size() < parameters.sampleSize;
+		if (!prefix.isEmpty())
+			sample._windows.push_back(prefix);
+
+		return sample;
+	}
+
+	const qint64 startPosition = textDevice.pos();
+	const qint64 inputSize = textDevice.size() - startPosition;
+	if (inputSize <= 0)
+		return sample;
+
+	const qint64 size = windowSize(inputSize, parameters);
+	sample._isComplete = size == inputSize;
+	for (const qint64 offset: windowOffsets(inputSize, parameters))
+	{
+		if (!textDevice.seek(startPosition + offset))
+			break;
+
+		QByteArray window = textDevice.read(size);
+		if (window.isEmpty())
+		{
+			sample._isComplete = false;
+			break;
+		}
+
+		sample._windows.push_back(std::move(window));
+	}
+
+	textDevice.seek(startPosition);
+	return sample;
+}
+
+qint64 CTextSample::size() const
+{
+	qint64 totalSize = 0;
+	for (const QByteArray& window: _windows)
+		totalSize += window.size();
+
+	return totalSize;
+}
+
+CTextSample CTextSample::truncated(qint64 maxSize) const
+{
+	if (size() <= maxSize)
+		return *this;
+
+	const qint64 windowSizeLimit = std::max((maxSize / (qint64)_windows.size()) & ~qint64{3}, qint64{4});
+
+	CTextSample sample;
+	for (const QByteArray& window: _windows)
+		sample._windows.push_back(window.size() <= windowSizeLimit ? window : QByteArray::fromRawData(window.constData(), windowSizeLimit));
+
+	return sample;
+}
+
+std::vector<qint64> CTextSample::windowOffsets(qint64 inputSize, const Parameters& parameters)
+{
+	assert_r(parameters.sampleSize > 0 && parameters.numChunks > 0);
+
+	const qint64 size = windowSize(inputSize, parameters);
+	if (size == inputSize)
+		return {0};
+
+	const qint64 stride = parameters.numChunks > 1 ? (inputSize - size) / (parameters.numChunks - 1) : 0;
+	std::vector<qint64> offsets;
+	offsets.reserve((size_t)parameters.numChunks);
+	for (qint64 i = 0; i < parameters.numChunks; ++i)
+		offsets.push_back((i * stride) & ~qint64{3});
+
+	return offsets;
+}
+
+qint64 CTextSample::windowSize(qint64 inputSize, const Parameters& parameters)
+{
+	if (inputSize <= parameters.sampleSize)
+		return inputSize;
+
+	return std::max((parameters.sampleSize / parameters.numChunks) & ~qint64{3}, qint64{4});
+}
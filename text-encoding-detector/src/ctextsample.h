@@ -0,0 +1,51 @@
+#pragma once
+
+#include "compiler/compiler_warnings_control.h"
+
+DISABLE_COMPILER_WARNINGS
+#include <QByteArray>
+RESTORE_COMPILER_WARNINGS
+
+#include <vector>
+
+class QIODevice;
+
+// A bounded sample of the input: up to Parameters::sampleSize bytes taken as Parameters::numChunks evenly spaced windows.
+// Only these bytes are decoded and analyzed for each candidate codec, so the cost of the detection does not depend on the input size.
+class CTextSample
+{
+public:
+	struct Parameters
+	{
+		qint64 sampleSize = 10000; // Bytes
+		qint64 numChunks = 10;
+	};
+
+	// Inputs that fit into the sample size are taken whole, as a single window.
+	// The windows reference textData without copying it, so textData (or the memory it wraps with QByteArray::fromRawData) must outlive the sample.
+	[[nodiscard]] static CTextSample fromData(const QByteArray& textData, const Parameters& parameters);
+	// How long reading from a sequential device waits for more data; a device that stays silent for longer is treated as having ended
+	static constexpr int sequentialReadTimeoutMs = 30 * 1000;
+
+	// Random-access devices are sampled by seeking from the current position, which is restored afterwards; only the windows are read.
+	// Sequential devices (sockets, pipes, processes) can only be sampled by reading a prefix of up to sampleSize bytes, which is consumed.
+	[[nodiscard]] static CTextSample fromDevice(QIODevice& textDevice, const Parameters& parameters);
+
+	[[nodiscard]] inline const std::vector<QByteArray>& windows() const {return _windows;}
+	[[nodiscard]] inline bool isEmpty() const {return _windows.empty();}
+	// The sample holds the whole input, not just a part of it
+	[[nodiscard]] inline bool isComplete() const {return _isComplete;}
+	[[nodiscard]] qint64 size() const;
+
+	// A smaller sample of up to maxSize bytes made of the beginnings of all the windows (at least 4 bytes of each), so it still covers the whole input.
+	// The windows reference the ones of this sample, which must outlive the result.
+	[[nodiscard]] CTextSample truncated(qint64 maxSize) const;
+
+	// The offsets of the windows for an input of the given size. The offsets are multiples of 4 so that UTF-16 and UTF-32 code units are never split.
+	[[nodiscard]] static std::vector<qint64> windowOffsets(qint64 inputSize, const Parameters& parameters);
+	[[nodiscard]] static qint64 windowSize(qint64 inputSize, const Parameters& parameters);
+
+private:
+	std::vector<QByteArray> _windows;
+	bool _isComplete = false;
+};
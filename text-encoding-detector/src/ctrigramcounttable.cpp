@@ -0,0 +1,51 @@
+#include "ctrigramcounttable.h"
+#include "assert/advanced_assert.h"
+
+#include <algorithm>
+
+CTrigramCountTable::CTrigramCountTable(size_t expectedNumberOfKeys)
+{
+	// Keeping the load factor at or below 0.5
+	size_t capacity = 16;
+	while (capacity < expectedNumberOfKeys * 2)
+		capacity *= 2;
+
+	rehash(capacity);
+}
+
+void CTrigramCountTable::clear()
+{
+	if (_size == 0)
+		return;
+
+	std::fill(_slots.begin(), _slots.end(), Slot{emptyKey, 0});
+	_size = 0;
+}
+
+void CTrigramCountTable::merge(const CTrigramCountTable& other)
+{
+	for (const Slot& slot: other)
+		add(slot.key, slot.count);
+}
+
+void CTrigramCountTable::rehash(size_t newCapacity)
+{
+	assert_r((newCapacity & (newCapacity - 1)) == 0);
+
+	std::vector<Slot> oldSlots(newCapacity, Slot{emptyKey, 0});
+	oldSlots.swap(_slots);
+
+	_shift = 64;
+	for (size_t capacity = newCapacity; capacity > 1; capacity /= 2)
+		--_shift;
+
+	_size = 0;
+	for (const Slot& slot: oldSlots)
+	{
+		if (slot.key != emptyKey)
+		{
+			_slots[findSlot(slot.key)] = slot;
+			++_size;
+		}
+	}
+}
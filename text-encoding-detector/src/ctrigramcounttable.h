@@ -0,0 +1,104 @@
+#pragma once
+
+#include "compiler/compiler_warnings_control.h"
+
+DISABLE_COMPILER_WARNINGS
+#include <QtGlobal>
+RESTORE_COMPILER_WARNINGS
+
+#include <vector>
+#include <stddef.h>
+
+// Open-addressing hash table (linear probing, power-of-two capacity) mapping packed trigrams to their occurrence counts.
+// The slots are stored in a single flat array, so counting a trigram is a multiplication, a shift and usually a single cache line access.
+// clear() keeps the allocated memory, so a table that is reused doesn't allocate once it has grown to the working size.
+class CTrigramCountTable
+{
+public:
+	using Key = quint64;
+
+	struct Slot
+	{
+		Key key;
+		quint64 count;
+	};
+
+	class const_iterator
+	{
+	public:
+		inline const_iterator(const Slot* slot, const Slot* end) : _slot(slot), _end(end) {skipEmpty();}
+
+		inline const Slot& operator*() const {return *_slot;}
+		inline const Slot* operator->() const {return _slot;}
+		inline const_iterator& operator++() {++_slot; skipEmpty(); return *this;}
+		inline bool operator==(const const_iterator& other) const {return _slot == other._slot;}
+		inline bool operator!=(const const_iterator& other) const {return _slot != other._slot;}
+
+	private:
+		inline void skipEmpty() {
+			while (_slot != _end && _slot->key == emptyKey)
+				++_slot;
+		}
+
+	private:
+		const Slot* _slot;
+		const Slot* _end;
+	};
+
+	explicit CTrigramCountTable(size_t expectedNumberOfKeys = 4096);
+
+	inline void add(const Key key, const quint64 count = 1) {
+		Slot* slot = &_slots[findSlot(key)];
+		if (slot->key == emptyKey)
+		{
+			if (_size >= _slots.size() / 2)
+			{
+				rehash(_slots.size() * 2);
+				slot = &_slots[findSlot(key)];
+			}
+
+			slot->key = key;
+			++_size;
+		}
+
+		slot->count += count;
+	}
+
+	// Adds the counts of all the keys of the other table
+	void merge(const CTrigramCountTable& other);
+
+	// Returns 0 if the key is not in the table
+	[[nodiscard]] inline quint64 count(const Key key) const {
+		const Slot& slot = _slots[findSlot(key)];
+		return slot.key == key ? slot.count : 0;
+	}
+
+	[[nodiscard]] inline size_t size() const {return _size;}
+	[[nodiscard]] inline bool empty() const {return _size == 0;}
+
+	[[nodiscard]] inline const_iterator begin() const {return const_iterator(_slots.data(), _slots.data() + _slots.size());}
+	[[nodiscard]] inline const_iterator end() const {return const_iterator(_slots.data() + _slots.size(), _slots.data() + _slots.size());}
+
+	void clear();
+
+private:
+	// Returns the index of the slot holding the key, or of the empty slot where it should be inserted
+	[[nodiscard]] inline size_t findSlot(const Key key) const {
+		// Fibonacci hashing: the high bits of the product are well mixed even for keys that only differ in the low bits
+		size_t index = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> _shift);
+		while (_slots[index].key != key && _slots[index].key != emptyKey)
+			index = (index + 1) & (_slots.size() - 1);
+
+		return index;
+	}
+
+	void rehash(size_t newCapacity);
+
+private:
+	// Packed trigrams only use the lower 63 bits, so this value never occurs as a key
+	static constexpr Key emptyKey = ~Key{0};
+
+	std::vector<Slot> _slots;
+	size_t _size = 0;
+	unsigned int _shift = 0;
+};
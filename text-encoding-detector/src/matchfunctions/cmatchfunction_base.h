@@ -0,0 +1,29 @@
+#pragma once
+
+#include "../ctextparser.h"
+
+#include <vector>
+
+class CTrigramFrequencyTable_Base;
+
+// Scores a sample against the language tables. An instance is created for a fixed set of tables, so any model-side terms are precomputed once, in the constructor.
+// match() must be thread-safe: the detector calls it concurrently from its worker threads.
+class CMatchFunction_Base
+{
+public:
+	virtual ~CMatchFunction_Base() = default;
+
+	// Returns the match of the sample against each of the tables, in the order they were passed to the constructor; higher is better
+	[[nodiscard]] virtual std::vector<float> match(const CTextParser::OccurrenceTable& sample) const = 0;
+
+	// The best match must exceed this value for the input to pass for text in one of the languages; CTextEncodingDetector::decode() refuses the inputs that don't.
+	// The match scale depends on the metric, so each one has its own value. The built-in metrics use the match that about 10% of the 150-character texts
+	// in a known language fall below, while random bytes stay under 0.01 with all of them. The default accepts any non-zero match.
+	[[nodiscard]] virtual float plausibleMatchThreshold() const {return 0.0f;}
+
+protected:
+	explicit CMatchFunction_Base(const std::vector<const CTrigramFrequencyTable_Base*>& tables) : _tables(tables) {}
+
+protected:
+	const std::vector<const CTrigramFrequencyTable_Base*> _tables;
+};
@@ -0,0 +1,45 @@
+#include "cmatchfunction_cosine.h"
+#include "../trigramfrequencytables/ctrigramfrequencytable_base.h"
+
+#include <math.h>
+
+CMatchFunction_Cosine::CMatchFunction_Cosine(const std::vector<const CTrigramFrequencyTable_Base*>& tables) :
+	CMatchFunction_Base(tables)
+{
+	for (const CTrigramFrequencyTable_Base* table: tables)
+	{
+		double squaredNorm = 0.0;
+		for (const auto& entry: *table)
+			squaredNorm += (double)entry.frequency * (double)entry.frequency;
+
+		_modelNorms.push_back(sqrt(squaredNorm));
+	}
+}
+
+std::vector<float> CMatchFunction_Cosine::match(const CTextParser::OccurrenceTable& sample) const
+{
+	std::vector<float> matches(_tables.size(), 0.0f);
+
+	// The raw counts are used: the cosine doesn't depend on the scale of the vectors
+	double squaredSampleNorm = 0.0;
+	for (const auto& n_gram: sample.trigramOccurrenceTable)
+		squaredSampleNorm += (double)n_gram.count * (double)n_gram.count;
+
+	if (squaredSampleNorm == 0.0)
+		return matches;
+
+	const double sampleNorm = sqrt(squaredSampleNorm);
+	for (size_t tableIndex = 0; tableIndex < _tables.size(); ++tableIndex)
+	{
+		if (_modelNorms[tableIndex] == 0.0)
+			continue;
+
+		double dotProduct = 0.0;
+		for (const auto& entry: *_tables[tableIndex])
+			dotProduct += (double)entry.frequency * (double)sample.trigramOccurrenceTable.count(entry.trigram);
+
+		matches[tableIndex] = (float)(dotProduct / (_modelNorms[tableIndex] * sampleNorm));
+	}
+
+	return matches;
+}
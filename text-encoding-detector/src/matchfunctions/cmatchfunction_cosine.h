@@ -0,0 +1,17 @@
+#pragma once
+
+#include "cmatchfunction_base.h"
+
+// Cosine similarity between the trigram frequency vectors of the sample and the model, from 0 (no common trigrams) to 1 (proportional vectors).
+// The model norms are precomputed, so a sample costs one linear pass for its own norm plus a hash lookup per model trigram.
+class CMatchFunction_Cosine final : public CMatchFunction_Base
+{
+public:
+	explicit CMatchFunction_Cosine(const std::vector<const CTrigramFrequencyTable_Base*>& tables);
+
+	[[nodiscard]] std::vector<float> match(const CTextParser::OccurrenceTable& sample) const override;
+	[[nodiscard]] float plausibleMatchThreshold() const override {return 0.16f;}
+
+private:
+	std::vector<double> _modelNorms;
+};
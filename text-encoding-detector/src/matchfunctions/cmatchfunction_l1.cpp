@@ -0,0 +1,69 @@
+#include "cmatchfunction_l1.h"
+#include "../trigramfrequencytables/ctrigramfrequencytable_base.h"
+
+#include "lang/type_traits_fast.hpp"
+
+#include <math.h>
+
+CMatchFunction_L1::CMatchFunction_L1(const std::vector<const CTrigramFrequencyTable_Base*>& tables) :
+	CMatchFunction_Base(tables)
+{
+	_models.reserve(tables.size());
+	for (const CTrigramFrequencyTable_Base* table: tables)
+	{
+		Model model;
+		model.trigrams.reserve(table->size());
+		model.frequencies.reserve(table->size());
+		for (const auto& entry: *table)
+		{
+			model.trigrams.push_back(entry.trigram);
+			model.frequencies.push_back(entry.frequency);
+		}
+
+		_models.push_back(std::move(model));
+	}
+}
+
+std::vector<float> CMatchFunction_L1::match(const CTextParser::OccurrenceTable& sample) const
+{
+	std::vector<float> matches(_tables.size(), 0.0f);
+	if (sample.trigramOccurrenceTable.empty())
+		return matches;
+
+	for (size_t tableIndex = 0; tableIndex < _tables.size(); ++tableIndex)
+	{
+		const Model& model = _models[tableIndex];
+		if (model.trigrams.empty())
+			continue;
+
+		// Performance optimization: it's faster to make a smaller number of lookups into a larger table than vice versa.
+		// A trigram missing from the other side has the frequency of 0 there, so |frequency - 0| adds the frequency itself without a branch.
+		float deviation = 0.0f;
+		if (model.trigrams.size() <= sample.trigramOccurrenceTable.size())
+		{
+			for (size_t i = 0, size = model.trigrams.size(); i < size; ++i)
+			{
+				const float sampleFrequency = (float)sample.trigramOccurrenceTable.count(model.trigrams[i]) / (float)sample.totalTrigramsCount;
+				deviation += fabsf(model.frequencies[i] - sampleFrequency);
+			}
+		}
+		else
+		{
+			for (const auto& n_gram: sample.trigramOccurrenceTable)
+			{
+				const auto* entry = _tables[tableIndex]->find(n_gram.key);
+				const float modelFrequency = entry ? entry->frequency : 0.0f;
+				deviation += fabsf((float)n_gram.count / (float)sample.totalTrigramsCount - modelFrequency);
+			}
+		}
+
+		matches[tableIndex] = matchFromDeviation(deviation);
+	}
+
+	return matches;
+}
+
+float CMatchFunction_L1::matchFromDeviation(const float deviation)
+{
+	return deviation > 1e-5f ? (1.0f / deviation - 1.0f) : float_max;
+}
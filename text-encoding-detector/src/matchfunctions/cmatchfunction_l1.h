@@ -0,0 +1,26 @@
+#pragma once
+
+#include "cmatchfunction_base.h"
+
+// The L1 deviation between the trigram frequencies of the sample and the model, counted over the smaller of the two; the match is 1 / deviation - 1.
+// Looks the trigrams of the smaller side up in the other one: hash lookups into the sample, or binary search in the model.
+class CMatchFunction_L1 final : public CMatchFunction_Base
+{
+public:
+	explicit CMatchFunction_L1(const std::vector<const CTrigramFrequencyTable_Base*>& tables);
+
+	[[nodiscard]] std::vector<float> match(const CTextParser::OccurrenceTable& sample) const override;
+	[[nodiscard]] float plausibleMatchThreshold() const override {return 0.1f;}
+
+	[[nodiscard]] static float matchFromDeviation(float deviation);
+
+private:
+	// The model trigrams and frequencies in separate arrays, so the lookup loop streams through them
+	struct Model
+	{
+		std::vector<CTextParser::Trigram> trigrams;
+		std::vector<float> frequencies;
+	};
+
+	std::vector<Model> _models;
+};
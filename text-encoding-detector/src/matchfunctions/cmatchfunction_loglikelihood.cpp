@@ -0,0 +1,51 @@
+#include "cmatchfunction_loglikelihood.h"
+#include "../trigramfrequencytables/ctrigramfrequencytable_base.h"
+
+#include <algorithm>
+
+#include <math.h>
+
+CMatchFunction_LogLikelihood::CMatchFunction_LogLikelihood(const std::vector<const CTrigramFrequencyTable_Base*>& tables) :
+	CMatchFunction_Base(tables)
+{
+	for (const CTrigramFrequencyTable_Base* table: tables)
+	{
+		Model model;
+		if (table->size() > 0)
+		{
+			const auto minmax = std::minmax_element(table->begin(), table->end(), [](const auto& l, const auto& r) {return l.frequency < r.frequency;});
+			const float logFloor = logf(minmax.first->frequency / 2.0f);
+
+			model.logProbabilityGains.reserve(table->size());
+			for (const auto& entry: *table)
+				model.logProbabilityGains.push_back(logf(entry.frequency) - logFloor);
+
+			model.maxLogProbabilityGain = logf(minmax.second->frequency) - logFloor;
+		}
+
+		_models.push_back(std::move(model));
+	}
+}
+
+std::vector<float> CMatchFunction_LogLikelihood::match(const CTextParser::OccurrenceTable& sample) const
+{
+	std::vector<float> matches(_tables.size(), 0.0f);
+	if (sample.totalTrigramsCount == 0)
+		return matches;
+
+	for (size_t tableIndex = 0; tableIndex < _tables.size(); ++tableIndex)
+	{
+		const Model& model = _models[tableIndex];
+		if (model.maxLogProbabilityGain <= 0.0f)
+			continue;
+
+		double logLikelihoodGain = 0.0;
+		const auto* entries = _tables[tableIndex]->begin();
+		for (size_t i = 0, size = model.logProbabilityGains.size(); i < size; ++i)
+			logLikelihoodGain += (double)sample.trigramOccurrenceTable.count(entries[i].trigram) * (double)model.logProbabilityGains[i];
+
+		matches[tableIndex] = (float)(logLikelihoodGain / ((double)sample.totalTrigramsCount * (double)model.maxLogProbabilityGain));
+	}
+
+	return matches;
+}
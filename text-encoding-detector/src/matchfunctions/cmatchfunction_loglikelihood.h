@@ -0,0 +1,25 @@
+#pragma once
+
+#include "cmatchfunction_base.h"
+
+// Naive Bayes log-likelihood of the sample trigrams under the model. A trigram missing from the table gets a floor probability of half its least frequent trigram.
+// The result is the average log-likelihood gain of a sample trigram over the floor, normalized by the gain of the most frequent model trigram, so it's in [0, 1].
+// The log-probabilities are precomputed, and the trigrams at the floor contribute nothing, so a sample costs a hash lookup per model trigram.
+// The average stabilizes after a few hundred trigrams, which makes this metric a good fit for small samples and Options::earlyExitMatch.
+class CMatchFunction_LogLikelihood final : public CMatchFunction_Base
+{
+public:
+	explicit CMatchFunction_LogLikelihood(const std::vector<const CTrigramFrequencyTable_Base*>& tables);
+
+	[[nodiscard]] std::vector<float> match(const CTextParser::OccurrenceTable& sample) const override;
+	[[nodiscard]] float plausibleMatchThreshold() const override {return 0.14f;}
+
+private:
+	struct Model
+	{
+		std::vector<float> logProbabilityGains; // log(frequency) - log(floor) for every entry of the table
+		float maxLogProbabilityGain = 0.0f;
+	};
+
+	std::vector<Model> _models;
+};
@@ -0,0 +1,73 @@
+#include "cmatchfunction_outofplace.h"
+#include "../trigramfrequencytables/ctrigramfrequencytable_base.h"
+
+#include <algorithm>
+#include <numeric>
+
+CMatchFunction_OutOfPlace::CMatchFunction_OutOfPlace(const std::vector<const CTrigramFrequencyTable_Base*>& tables) :
+	CMatchFunction_Base(tables)
+{
+	for (const CTrigramFrequencyTable_Base* table: tables)
+	{
+		const auto* entries = table->begin();
+		std::vector<quint32> entriesByFrequency(table->size());
+		std::iota(entriesByFrequency.begin(), entriesByFrequency.end(), 0u);
+		// The entries are sorted by trigram, so the stable sort breaks the ties by trigram
+		std::stable_sort(entriesByFrequency.begin(), entriesByFrequency.end(), [entries](const quint32 l, const quint32 r) {return entries[l].frequency > entries[r].frequency;});
+
+		std::vector<quint32> ranks(table->size());
+		for (quint32 rank = 0; rank < (quint32)entriesByFrequency.size(); ++rank)
+			ranks[entriesByFrequency[rank]] = rank;
+
+		_modelRanks.push_back(std::move(ranks));
+	}
+}
+
+std::vector<float> CMatchFunction_OutOfPlace::match(const CTextParser::OccurrenceTable& sample) const
+{
+	std::vector<float> matches(_tables.size(), 0.0f);
+	if (sample.trigramOccurrenceTable.empty())
+		return matches;
+
+	// All the tables usually have about the same size, so the sample is ranked once, up to the largest of them
+	size_t maxModelSize = 0;
+	for (const CTrigramFrequencyTable_Base* table: _tables)
+		maxModelSize = std::max(maxModelSize, table->size());
+
+	std::vector<CTrigramCountTable::Slot> rankedSample;
+	rankedSample.reserve(sample.trigramOccurrenceTable.size());
+	for (const auto& n_gram: sample.trigramOccurrenceTable)
+		rankedSample.push_back(n_gram);
+
+	const size_t numRanked = std::min(maxModelSize, rankedSample.size());
+	std::partial_sort(rankedSample.begin(), rankedSample.begin() + (ptrdiff_t)numRanked, rankedSample.end(), [](const CTrigramCountTable::Slot& l, const CTrigramCountTable::Slot& r) {
+		return l.count != r.count ? l.count > r.count : l.key < r.key;
+	});
+
+	for (size_t tableIndex = 0; tableIndex < _tables.size(); ++tableIndex)
+	{
+		const CTrigramFrequencyTable_Base& model = *_tables[tableIndex];
+		const size_t modelSize = model.size();
+		if (modelSize == 0)
+			continue;
+
+		const size_t numCompared = std::min(modelSize, numRanked);
+		quint64 distance = 0;
+		for (size_t sampleRank = 0; sampleRank < numCompared; ++sampleRank)
+		{
+			const auto* entry = model.find(rankedSample[sampleRank].key);
+			if (!entry)
+			{
+				distance += modelSize;
+				continue;
+			}
+
+			const size_t modelRank = _modelRanks[tableIndex][(size_t)(entry - model.begin())];
+			distance += modelRank > sampleRank ? modelRank - sampleRank : sampleRank - modelRank;
+		}
+
+		matches[tableIndex] = 1.0f - (float)((double)distance / ((double)numCompared * (double)modelSize));
+	}
+
+	return matches;
+}
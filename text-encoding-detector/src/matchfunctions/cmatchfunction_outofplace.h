@@ -0,0 +1,19 @@
+#pragma once
+
+#include "cmatchfunction_base.h"
+
+// Cavnar-Trenkle rank-order ("out-of-place") distance: the sample's most frequent trigrams, as many as the model has, are ranked by count,
+// and each one adds the difference between its rank in the sample and in the model, or the number of model trigrams if the model doesn't have it.
+// The match is 1 - distance / (the maximum distance), from 0 to 1. The model ranks are precomputed.
+class CMatchFunction_OutOfPlace final : public CMatchFunction_Base
+{
+public:
+	explicit CMatchFunction_OutOfPlace(const std::vector<const CTrigramFrequencyTable_Base*>& tables);
+
+	[[nodiscard]] std::vector<float> match(const CTextParser::OccurrenceTable& sample) const override;
+	[[nodiscard]] float plausibleMatchThreshold() const override {return 0.2f;}
+
+private:
+	// The rank of each table entry by frequency (0 is the most frequent), in the order of the entries
+	std::vector<std::vector<quint32>> _modelRanks;
+};
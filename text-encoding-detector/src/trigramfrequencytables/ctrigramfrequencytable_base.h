@@ -2,15 +2,52 @@
 
 #include "../ctextparser.h"
 
+#include <algorithm>
+#include <stddef.h>
+
+// The tables are generated by text_analyzer as constexpr arrays sorted by the packed trigram, so constructing a table costs nothing at runtime.
+// CTrigramFrequencyTable_File uses the same entries memory-mapped from a binary model file.
 class CTrigramFrequencyTable_Base
 {
 public:
+	struct Entry
+	{
+		CTextParser::Trigram trigram; // See CTextParser::packTrigram()
+		float frequency; // The number of occurrences of this trigram divided by the number of all the trigrams in the table
+	};
+
 	virtual ~CTrigramFrequencyTable_Base() = default;
 
-	[[nodiscard]] inline const CTextParser::OccurrenceTable& trigramOccurrenceTable() const {return _table;}
+	[[nodiscard]] inline const Entry* begin() const {return _entries;}
+	[[nodiscard]] inline const Entry* end() const {return _entries + _size;}
+	[[nodiscard]] inline size_t size() const {return _size;}
+
+	// Binary search; returns nullptr if the trigram is not in the table
+	[[nodiscard]] inline const Entry* find(const CTextParser::Trigram trigram) const {
+		const auto it = std::lower_bound(begin(), end(), trigram, [](const Entry& entry, const CTextParser::Trigram value) {return entry.trigram < value;});
+		return it != end() && it->trigram == trigram ? it : nullptr;
+	}
 
 	[[nodiscard]] virtual QString language() const = 0;
 
+	template <size_t N>
+	[[nodiscard]] static constexpr bool isSorted(const Entry (&entries)[N]) {
+		for (size_t i = 1; i < N; ++i)
+		{
+			if (!(entries[i - 1].trigram < entries[i].trigram))
+				return false;
+		}
+
+		return true;
+	}
+
 protected:
-	CTextParser::OccurrenceTable _table;
+	template <size_t N>
+	constexpr explicit CTrigramFrequencyTable_Base(const Entry (&entries)[N]) : _entries(entries), _size(N) {}
+	// For the tables that are not compiled in; the entries must be sorted and outlive the table
+	constexpr CTrigramFrequencyTable_Base(const Entry* entries, size_t size) : _entries(entries), _size(size) {}
+
+private:
+	const Entry* _entries;
+	size_t _size;
 };
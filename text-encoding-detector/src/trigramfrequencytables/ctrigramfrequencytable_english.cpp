@@ -1,471 +1,463 @@
 #include "ctrigramfrequencytable_english.h"
 
-
-struct Trigram {
-	const char * trigram;
-	quint64 count;
+// Sorted by the packed trigram value, see CTextParser::packTrigram()
+static constexpr CTrigramFrequencyTable_Base::Entry trigrams[] = {
+	{0x000184000c40006cull, 0.00106408459f}, // abl
+	{0x000184000c40006full, 0.00142787653f}, // abo
+	{0x000184000c600065ull, 0.00133487501f}, // ace
+	{0x000184000c600068ull, 0.00105666567f}, // ach
+	{0x000184000c60006bull, 0.0012794981f}, // ack
+	{0x000184000c600074ull, 0.0010961449f}, // act
+	{0x000184000c800065ull, 0.00132136198f}, // ade
+	{0x000184000ce00065ull, 0.00124081376f}, // age
+	{0x000184000d200064ull, 0.0028327012f}, // aid
+	{0x000184000d20006eull, 0.00264007435f}, // ain
+	{0x000184000d200072ull, 0.00109746971f}, // air
+	{0x000184000d600065ull, 0.00154339965f}, // ake
+	{0x000184000d800069ull, 0.00128188275f}, // ali
+	{0x000184000d80006cull, 0.00445214473f}, // all
+	{0x000184000da00065ull, 0.00184625038f}, // ame
+	{0x000184000dc00061ull, 0.00128559221f}, // ana
+	{0x000184000dc00063ull, 0.0015834088f}, // anc
+	{0x000184000dc00064ull, 0.0129195135f}, // and
+	{0x000184000dc00067ull, 0.00126254058f}, // ang
+	{0x000184000dc00069ull, 0.0012288905f}, // ani
+	{0x000184000dc00073ull, 0.00149782631f}, // ans
+	{0x000184000dc00074ull, 0.00309395324f}, // ant
+	{0x000184000dc00079ull, 0.00192361907f}, // any
+	{0x000184000e000070ull, 0.00105640071f}, // app
+	{0x000184000e400064ull, 0.00240584859f}, // ard
+	{0x000184000e400065ull, 0.00255846628f}, // are
+	{0x000184000e400074ull, 0.00214910111f}, // art
+	{0x000184000e600061ull, 0.00207623676f}, // asa
+	{0x000184000e600065ull, 0.00101241714f}, // ase
+	{0x000184000e600068ull, 0.00125724135f}, // ash
+	{0x000184000e600069ull, 0.00151716848f}, // asi
+	{0x000184000e600073ull, 0.00186453271f}, // ass
+	{0x000184000e600074ull, 0.00348344631f}, // ast
+	{0x000184000e800065ull, 0.00284939399f}, // ate
+	{0x000184000e800068ull, 0.00274764863f}, // ath
+	{0x000184000e800069ull, 0.003451386f}, // ati
+	{0x000184000e800073ull, 0.00132613129f}, // ats
+	{0x000184000e800074ull, 0.00325690443f}, // att
+	{0x000184000ec00065ull, 0.00297684036f}, // ave
+	{0x000184000f200073ull, 0.00103467389f}, // ays
+	{0x000188000ca00065ull, 0.0012617457f}, // bee
+	{0x000188000d800065ull, 0.00169018819f}, // ble
+	{0x000188000de00075ull, 0.00119736011f}, // bou
+	{0x000188000ea00074ull, 0.00304281572f}, // but
+	{0x00018c000c20006cull, 0.0010619649f}, // cal
+	{0x00018c000c20006eull, 0.00138521765f}, // can
+	{0x00018c000c200072ull, 0.00102857978f}, // car
+	{0x00018c000d000061ull, 0.00174662494f}, // cha
+	{0x00018c000d000065ull, 0.0012453181f}, // che
+	{0x00018c000d000069ull, 0.00116132537f}, // chi
+	{0x00018c000de0006dull, 0.00190639659f}, // com
+	{0x00018c000de0006eull, 0.00245195185f}, // con
+	{0x00018c000de00075ull, 0.00235126656f}, // cou
+	{0x00018c000e800069ull, 0.00119153096f}, // cti
+	{0x000190000c20006eull, 0.00217268267f}, // dan
+	{0x000190000c400065ull, 0.00183565193f}, // dbe
+	{0x000190000ca00061ull, 0.000986185973f}, // dea
+	{0x000190000ca00064ull, 0.00132904586f}, // ded
+	{0x000190000ca0006eull, 0.00173470168f}, // den
+	{0x000190000ca00072ull, 0.00223229895f}, // der
+	{0x000190000ca00073ull, 0.00107998226f}, // des
+	{0x000190000d000065ull, 0.0020205949f}, // dhe
+	{0x000190000d000069ull, 0.00161202461f}, // dhi
+	{0x000190000d200064ull, 0.00155028864f}, // did
+	{0x000190000d20006eull, 0.00265809172f}, // din
+	{0x000190000d200073ull, 0.00120742864f}, // dis
+	{0x000190000d200074ull, 0.00140244013f}, // dit
+	{0x000190000dc0006full, 0.00177842029f}, // dno
+	{0x000190000de00066ull, 0.001116017f}, // dof
+	{0x000190000de0006eull, 0.00245248177f}, // don
+	{0x000190000de00077ull, 0.00105693063f}, // dow
+	{0x000190000e400065ull, 0.00116582972f}, // dre
+	{0x000190000e800068ull, 0.00582411466f}, // dth
+	{0x000190000e80006full, 0.00285919756f}, // dto
+	{0x000194000c200064ull, 0.00182240386f}, // ead
+	{0x000194000c20006cull, 0.00172834261f}, // eal
+	{0x000194000c20006eull, 0.00316549279f}, // ean
+	{0x000194000c200072ull, 0.0036675944f}, // ear
+	{0x000194000c200073ull, 0.00217798189f}, // eas
+	{0x000194000c200074ull, 0.001958329f}, // eat
+	{0x000194000c400065ull, 0.00120212941f}, // ebe
+	{0x000194000c600061ull, 0.00176252262f}, // eca
+	{0x000194000c60006full, 0.00255210721f}, // eco
+	{0x000194000c600074ull, 0.00159347733f}, // ect
+	{0x000194000c800061ull, 0.00328313559f}, // eda
+	{0x000194000c800062ull, 0.00113164971f}, // edb
+	{0x000194000c800065ull, 0.00118676166f}, // ede
+	{0x000194000c800068ull, 0.00206007413f}, // edh
+	{0x000194000c800069ull, 0.00303592673f}, // edi
+	{0x000194000c80006full, 0.00227071834f}, // edo
+	{0x000194000c800073ull, 0.00105693063f}, // eds
+	{0x000194000c800074ull, 0.00465272041f}, // edt
+	{0x000194000c800077ull, 0.0011419832f}, // edw
+	{0x000194000ca0006eull, 0.00224607694f}, // een
+	{0x000194000cc0006full, 0.00155108352f}, // efo
+	{0x000194000d000061ull, 0.0028327012f}, // eha
+	{0x000194000d000065ull, 0.0021758622f}, // ehe
+	{0x000194000d000069ull, 0.00115311157f}, // ehi
+	{0x000194000d20006eull, 0.0022791971f}, // ein
+	{0x000194000d200072ull, 0.00115576119f}, // eir
+	{0x000194000d200074ull, 0.00142469699f}, // eit
+	{0x000194000d800061ull, 0.00104023807f}, // ela
+	{0x000194000d800065ull, 0.00112794025f}, // ele
+	{0x000194000d800069ull, 0.00162633252f}, // eli
+	{0x000194000d80006cull, 0.00212949398f}, // ell
+	{0x000194000d80006full, 0.00101427187f}, // elo
+	{0x000194000da00061ull, 0.00179988216f}, // ema
+	{0x000194000da00065ull, 0.00225482066f}, // eme
+	{0x000194000da0006full, 0.00137859362f}, // emo
+	{0x000194000dc00061ull, 0.00146470615f}, // ena
+	{0x000194000dc00063ull, 0.00158208399f}, // enc
+	{0x000194000dc00064ull, 0.0016374609f}, // end
+	{0x000194000dc00065ull, 0.00174424029f}, // ene
+	{0x000194000dc00069ull, 0.00128214771f}, // eni
+	{0x000194000dc0006full, 0.00168303424f}, // eno
+	{0x000194000dc00073ull, 0.00151743344f}, // ens
+	{0x000194000dc00074ull, 0.00699232891f}, // ent
+	{0x000194000de00066ull, 0.00298266951f}, // eof
+	{0x000194000de0006eull, 0.00121802709f}, // eon
+	{0x000194000e000072ull, 0.00100950256f}, // epr
+	{0x000194000e400061ull, 0.00265809172f}, // era
+	{0x000194000e400065ull, 0.00838205125f}, // ere
+	{0x000194000e400068ull, 0.00138495269f}, // erh
+	{0x000194000e400069ull, 0.00236292486f}, // eri
+	{0x000194000e40006full, 0.00161599903f}, // ero
+	{0x000194000e400073ull, 0.0041622771f}, // ers
+	{0x000194000e400074ull, 0.00292861741f}, // ert
+	{0x000194000e400077ull, 0.00116238522f}, // erw
+	{0x000194000e400079ull, 0.00143847498f}, // ery
+	{0x000194000e600061ull, 0.00283720554f}, // esa
+	{0x000194000e600065ull, 0.00158711825f}, // ese
+	{0x000194000e600068ull, 0.00174265052f}, // esh
+	{0x000194000e600069ull, 0.00153624569f}, // esi
+	{0x000194000e60006full, 0.00164646958f}, // eso
+	{0x000194000e600073ull, 0.00347576244f}, // ess
+	{0x000194000e600074ull, 0.00455892412f}, // est
+	{0x000194000e800061ull, 0.00105057156f}, // eta
+	{0x000194000e800068ull, 0.00662509259f}, // eth
+	{0x000194000e800069ull, 0.00101135729f}, // eti
+	{0x000194000e80006full, 0.00298717385f}, // eto
+	{0x000194000e800074ull, 0.00119709515f}, // ett
+	{0x000194000ec00065ull, 0.00371396262f}, // eve
+	{0x000194000ee00061ull, 0.00342038553f}, // ewa
+	{0x000194000ee00065ull, 0.00111522211f}, // ewe
+	{0x000194000ee00068ull, 0.00158234895f}, // ewh
+	{0x000194000ee00069ull, 0.00122359127f}, // ewi
+	{0x000194000ee0006full, 0.00147609948f}, // ewo
+	{0x000194000f20006full, 0.00138495269f}, // eyo
+	{0x000198000c200063ull, 0.00113244459f}, // fac
+	{0x000198000de00072ull, 0.00532704685f}, // for
+	{0x000198000e40006full, 0.00174238556f}, // fro
+	{0x000198000e800068ull, 0.00398687273f}, // fth
+	{0x00019c000ca00074ull, 0.0012453181f}, // get
+	{0x00019c000d000074ull, 0.0044762562f}, // ght
+	{0x00019c000d20006eull, 0.00116291514f}, // gin
+	{0x00019c000e400065ull, 0.00102540024f}, // gre
+	{0x00019c000e800068ull, 0.00183353224f}, // gth
+	{0x00019c000e80006full, 0.00111442723f}, // gto
+	{0x0001a0000c200064ull, 0.00496034045f}, // had
+	{0x0001a0000c20006eull, 0.00236424967f}, // han
+	{0x0001a0000c200072ull, 0.00104288768f}, // har
+	{0x0001a0000c200074ull, 0.00856381468f}, // hat
+	{0x0001a0000c200076ull, 0.00213267352f}, // hav
+	{0x0001a0000ca00061ull, 0.00300386641f}, // hea
+	{0x0001a0000ca00062ull, 0.00163825578f}, // heb
+	{0x0001a0000ca00063ull, 0.00307408115f}, // hec
+	{0x0001a0000ca00064ull, 0.00326485327f}, // hed
+	{0x0001a0000ca00065ull, 0.0012206767f}, // hee
+	{0x0001a0000ca00066ull, 0.00191408047f}, // hef
+	{0x0001a0000ca00067ull, 0.00120000972f}, // heg
+	{0x0001a0000ca00068ull, 0.0028032905f}, // heh
+	{0x0001a0000ca00069ull, 0.00178424944f}, // hei
+	{0x0001a0000ca0006cull, 0.00255237217f}, // hel
+	{0x0001a0000ca0006dull, 0.00334275188f}, // hem
+	{0x0001a0000ca0006eull, 0.0038543921f}, // hen
+	{0x0001a0000ca0006full, 0.00126360042f}, // heo
+	{0x0001a0000ca00070ull, 0.00205398002f}, // hep
+	{0x0001a0000ca00072ull, 0.010467561f}, // her
+	{0x0001a0000ca00073ull, 0.00554166548f}, // hes
+	{0x0001a0000ca00074ull, 0.00232768501f}, // het
+	{0x0001a0000ca00077ull, 0.00381226325f}, // hew
+	{0x0001a0000ca00079ull, 0.00264325389f}, // hey
+	{0x0001a0000d200063ull, 0.00120106956f}, // hic
+	{0x0001a0000d20006dull, 0.00295299385f}, // him
+	{0x0001a0000d20006eull, 0.00383452f}, // hin
+	{0x0001a0000d200073ull, 0.00684209587f}, // his
+	{0x0001a0000de00075ull, 0.00276646088f}, // hou
+	{0x0001a0000de00077ull, 0.00133725966f}, // how
+	{0x0001a0000e800068ull, 0.00170979532f}, // hth
+	{0x0001a4000c600061ull, 0.00128956663f}, // ica
+	{0x0001a4000c600065ull, 0.00169416261f}, // ice
+	{0x0001a4000c600068ull, 0.00151504879f}, // ich
+	{0x0001a4000c800065ull, 0.00195435458f}, // ide
+	{0x0001a4000ce00068ull, 0.00323703233f}, // igh
+	{0x0001a4000d600065ull, 0.00125856616f}, // ike
+	{0x0001a4000d800065ull, 0.00150657003f}, // ile
+	{0x0001a4000d80006cull, 0.0030470551f}, // ill
+	{0x0001a4000da00065ull, 0.00157863949f}, // ime
+	{0x0001a4000dc00061ull, 0.00181233534f}, // ina
+	{0x0001a4000dc00063ull, 0.0010783925f}, // inc
+	{0x0001a4000dc00064ull, 0.00203304808f}, // ind
+	{0x0001a4000dc00065ull, 0.00236530951f}, // ine
+	{0x0001a4000dc00067ull, 0.0145628033f}, // ing
+	{0x0001a4000dc00073ull, 0.00170423114f}, // ins
+	{0x0001a4000dc00074ull, 0.00487396307f}, // int
+	{0x0001a4000de0006eull, 0.00462516444f}, // ion
+	{0x0001a4000e400065ull, 0.00101639156f}, // ire
+	{0x0001a4000e600061ull, 0.00110144413f}, // isa
+	{0x0001a4000e600065ull, 0.00108369172f}, // ise
+	{0x0001a4000e600068ull, 0.00172993238f}, // ish
+	{0x0001a4000e600073ull, 0.00119736011f}, // iss
+	{0x0001a4000e600074ull, 0.00251289294f}, // ist
+	{0x0001a4000e800061ull, 0.00105825544f}, // ita
+	{0x0001a4000e800065ull, 0.00124770275f}, // ite
+	{0x0001a4000e800068ull, 0.00450010272f}, // ith
+	{0x0001a4000e800069ull, 0.00161679392f}, // iti
+	{0x0001a4000e800073ull, 0.00168276927f}, // its
+	{0x0001a4000e800074ull, 0.00145013328f}, // itt
+	{0x0001a4000e800077ull, 0.00184572046f}, // itw
+	{0x0001a4000e800079ull, 0.00121405267f}, // ity
+	{0x0001a4000ec00065ull, 0.0025131579f}, // ive
+	{0x0001ac000ca00064ull, 0.00179855735f}, // ked
+	{0x0001ac000d20006eull, 0.00191222574f}, // kin
+	{0x0001ac000dc0006full, 0.0016011612f}, // kno
+	{0x0001b0000c20006eull, 0.00164858927f}, // lan
+	{0x0001b0000ca00061ull, 0.00188096031f}, // lea
+	{0x0001b0000ca00064ull, 0.00176119781f}, // led
+	{0x0001b0000ca00073ull, 0.00165786291f}, // les
+	{0x0001b0000ca00074ull, 0.00151213421f}, // let
+	{0x0001b0000d20006bull, 0.00117457344f}, // lik
+	{0x0001b0000d20006eull, 0.00203490281f}, // lin
+	{0x0001b0000d200074ull, 0.0012535319f}, // lit
+	{0x0001b0000d800065ull, 0.00122783065f}, // lle
+	{0x0001b0000d800069ull, 0.00132374663f}, // lli
+	{0x0001b0000d80006full, 0.00107706769f}, // llo
+	{0x0001b0000d800074ull, 0.00110250397f}, // llt
+	{0x0001b0000d800079ull, 0.00169601734f}, // lly
+	{0x0001b0000de0006eull, 0.00111204258f}, // lon
+	{0x0001b0000de0006full, 0.00143211591f}, // loo
+	{0x0001b0000de00077ull, 0.000999434036f}, // low
+	{0x0001b0000e800068ull, 0.00139528618f}, // lth
+	{0x0001b0000f200074ull, 0.000995194656f}, // lyt
+	{0x0001b4000c20006eull, 0.00284965895f}, // man
+	{0x0001b4000ca00061ull, 0.00128453237f}, // mea
+	{0x0001b4000ca00064ull, 0.00103440892f}, // med
+	{0x0001b4000ca0006eull, 0.00290159136f}, // men
+	{0x0001b4000ca00073ull, 0.00100950256f}, // mes
+	{0x0001b4000ca00074ull, 0.00174715486f}, // met
+	{0x0001b4000d20006cull, 0.00125220709f}, // mil
+	{0x0001b4000d20006eull, 0.00182478852f}, // min
+	{0x0001b4000de0006eull, 0.00109720475f}, // mon
+	{0x0001b4000de00072ull, 0.00140482478f}, // mor
+	{0x0001b4000e800068ull, 0.00122120662f}, // mth
+	{0x0001b8000c20006cull, 0.00116238522f}, // nal
+	{0x0001b8000c20006eull, 0.00153836538f}, // nan
+	{0x0001b8000c200074ull, 0.00112608552f}, // nat
+	{0x0001b8000c600065ull, 0.00301472982f}, // nce
+	{0x0001b8000c800061ull, 0.00163454632f}, // nda
+	{0x0001b8000c800065ull, 0.00226859865f}, // nde
+	{0x0001b8000c800068ull, 0.00123392476f}, // ndh
+	{0x0001b8000c800069ull, 0.00189659302f}, // ndi
+	{0x0001b8000c80006full, 0.00142072258f}, // ndo
+	{0x0001b8000c800073ull, 0.00197581644f}, // nds
+	{0x0001b8000c800074ull, 0.00259370613f}, // ndt
+	{0x0001b8000c800077ull, 0.00101029745f}, // ndw
+	{0x0001b8000ca00064ull, 0.00207358715f}, // ned
+	{0x0001b8000ca00073ull, 0.00200178265f}, // nes
+	{0x0001b8000ca00077ull, 0.0014718601f}, // new
+	{0x0001b8000ce00061ull, 0.00212075026f}, // nga
+	{0x0001b8000ce00065ull, 0.00152432243f}, // nge
+	{0x0001b8000ce00068ull, 0.00118808646f}, // ngh
+	{0x0001b8000ce00069ull, 0.00150498026f}, // ngi
+	{0x0001b8000ce0006full, 0.00111946149f}, // ngo
+	{0x0001b8000ce00073ull, 0.00152670708f}, // ngs
+	{0x0001b8000ce00074ull, 0.00312892813f}, // ngt
+	{0x0001b8000d000065ull, 0.00137806369f}, // nhe
+	{0x0001b8000d000069ull, 0.000997049385f}, // nhi
+	{0x0001b8000d20006eull, 0.00226727384f}, // nin
+	{0x0001b8000d800079ull, 0.00103308412f}, // nly
+	{0x0001b8000de00074ull, 0.00431568967f}, // not
+	{0x0001b8000de00077ull, 0.00277785421f}, // now
+	{0x0001b8000e600074ull, 0.00127790833f}, // nst
+	{0x0001b8000e800061ull, 0.00132772105f}, // nta
+	{0x0001b8000e800065ull, 0.00219599926f}, // nte
+	{0x0001b8000e800068ull, 0.00644491892f}, // nth
+	{0x0001b8000e800069ull, 0.00175059936f}, // nti
+	{0x0001b8000e80006full, 0.00258151791f}, // nto
+	{0x0001b8000e800073ull, 0.00122491608f}, // nts
+	{0x0001b8000e800074ull, 0.00118994119f}, // ntt
+	{0x0001bc000c400065ull, 0.00111230754f}, // obe
+	{0x0001bc000cc00061ull, 0.00158075918f}, // ofa
+	{0x0001bc000cc00066ull, 0.0012747288f}, // off
+	{0x0001bc000cc00068ull, 0.00125697639f}, // ofh
+	{0x0001bc000cc00074ull, 0.00388274295f}, // oft
+	{0x0001bc000d20006eull, 0.00116529979f}, // oin
+	{0x0001bc000d800064ull, 0.00152273267f}, // old
+	{0x0001bc000da00061ull, 0.000998374191f}, // oma
+	{0x0001bc000da00065ull, 0.00356134493f}, // ome
+	{0x0001bc000dc00061ull, 0.00160407578f}, // ona
+	{0x0001bc000dc00064ull, 0.000993339927f}, // ond
+	{0x0001bc000dc00065ull, 0.00416784128f}, // one
+	{0x0001bc000dc00067ull, 0.00124770275f}, // ong
+	{0x0001bc000dc00069ull, 0.00107044366f}, // oni
+	{0x0001bc000dc0006full, 0.0012288905f}, // ono
+	{0x0001bc000dc00073ull, 0.00213770778f}, // ons
+	{0x0001bc000dc00074ull, 0.00422745757f}, // ont
+	{0x0001bc000de00064ull, 0.0012760536f}, // ood
+	{0x0001bc000de0006bull, 0.00174768479f}, // ook
+	{0x0001bc000e400061ull, 0.00132825098f}, // ora
+	{0x0001bc000e400064ull, 0.00109190552f}, // ord
+	{0x0001bc000e400065ull, 0.00245884084f}, // ore
+	{0x0001bc000e400074ull, 0.00290344609f}, // ort
+	{0x0001bc000e600065ull, 0.00193898682f}, // ose
+	{0x0001bc000e600073ull, 0.00103202427f}, // oss
+	{0x0001bc000e600074ull, 0.00117059902f}, // ost
+	{0x0001bc000e800068ull, 0.00498842634f}, // oth
+	{0x0001bc000ea00067ull, 0.00227018842f}, // oug
+	{0x0001bc000ea0006cull, 0.00405178824f}, // oul
+	{0x0001bc000ea0006eull, 0.00235524098f}, // oun
+	{0x0001bc000ea00072ull, 0.00342806941f}, // our
+	{0x0001bc000ea00073ull, 0.00221242686f}, // ous
+	{0x0001bc000ea00074ull, 0.00384379365f}, // out
+	{0x0001bc000ec00065ull, 0.00220262329f}, // ove
+	{0x0001bc000ee00065ull, 0.0010455373f}, // owe
+	{0x0001bc000ee0006eull, 0.00182240386f}, // own
+	{0x0001c0000c200072ull, 0.00109190552f}, // par
+	{0x0001c0000ca00072ull, 0.00198138063f}, // per
+	{0x0001c0000d800061ull, 0.00114065839f}, // pla
+	{0x0001c0000d800065ull, 0.00121484755f}, // ple
+	{0x0001c0000e000065ull, 0.00104368257f}, // ppe
+	{0x0001c0000e400065ull, 0.00137806369f}, // pre
+	{0x0001c0000e40006full, 0.00169999176f}, // pro
+	{0x0001c8000c20006eull, 0.00251103821f}, // ran
+	{0x0001c8000c200074ull, 0.00121140305f}, // rat
+	{0x0001c8000c800065ull, 0.00116715452f}, // rde
+	{0x0001c8000ca00061ull, 0.00434033107f}, // rea
+	{0x0001c8000ca00063ull, 0.00121378771f}, // rec
+	{0x0001c8000ca00064ull, 0.00292199338f}, // red
+	{0x0001c8000ca00065ull, 0.00132666121f}, // ree
+	{0x0001c8000ca0006dull, 0.00110170909f}, // rem
+	{0x0001c8000ca0006eull, 0.00133858446f}, // ren
+	{0x0001c8000ca00073ull, 0.00342594972f}, // res
+	{0x0001c8000ca00074ull, 0.0021512208f}, // ret
+	{0x0001c8000ca00077ull, 0.00144483405f}, // rew
+	{0x0001c8000d200065ull, 0.00123154011f}, // rie
+	{0x0001c8000d20006eull, 0.00197449164f}, // rin
+	{0x0001c8000d200074ull, 0.00104951172f}, // rit
+	{0x0001c8000de0006dull, 0.00172383827f}, // rom
+	{0x0001c8000de00075ull, 0.0017633175f}, // rou
+	{0x0001c8000e600065ull, 0.00103679358f}, // rse
+	{0x0001c8000e600074ull, 0.00167455547f}, // rst
+	{0x0001c8000e800068ull, 0.00338673545f}, // rth
+	{0x0001c8000e80006full, 0.00111681188f}, // rto
+	{0x0001cc000c200069ull, 0.00266683544f}, // sai
+	{0x0001cc000c20006eull, 0.00265994645f}, // san
+	{0x0001cc000c60006full, 0.00116132537f}, // sco
+	{0x0001cc000ca00064ull, 0.00161202461f}, // sed
+	{0x0001cc000ca00065ull, 0.00145013328f}, // see
+	{0x0001cc000ca0006cull, 0.00137329439f}, // sel
+	{0x0001cc000ca0006eull, 0.00129751547f}, // sen
+	{0x0001cc000d000061ull, 0.00160963996f}, // sha
+	{0x0001cc000d000065ull, 0.00597991189f}, // she
+	{0x0001cc000d000069ull, 0.00105428102f}, // shi
+	{0x0001cc000d00006full, 0.00181366014f}, // sho
+	{0x0001cc000d200064ull, 0.00110806816f}, // sid
+	{0x0001cc000d20006eull, 0.00263371528f}, // sin
+	{0x0001cc000d200074ull, 0.00123392476f}, // sit
+	{0x0001cc000dc0006full, 0.00149199716f}, // sno
+	{0x0001cc000de00066ull, 0.00230807788f}, // sof
+	{0x0001cc000de0006dull, 0.00165839284f}, // som
+	{0x0001cc000de0006eull, 0.00200973148f}, // son
+	{0x0001cc000e000065ull, 0.00122385623f}, // spe
+	{0x0001cc000e600065ull, 0.00128903671f}, // sse
+	{0x0001cc000e600069ull, 0.00147080026f}, // ssi
+	{0x0001cc000e600074ull, 0.00112661545f}, // sst
+	{0x0001cc000e800061ull, 0.0031962283f}, // sta
+	{0x0001cc000e800065ull, 0.00213214359f}, // ste
+	{0x0001cc000e800068ull, 0.00433185231f}, // sth
+	{0x0001cc000e800069ull, 0.00219864887f}, // sti
+	{0x0001cc000e80006full, 0.00326352846f}, // sto
+	{0x0001cc000e800072ull, 0.00195938884f}, // str
+	{0x0001cc000ee00065ull, 0.00150233065f}, // swe
+	{0x0001cc000ee00068ull, 0.00103997311f}, // swh
+	{0x0001d0000c20006cull, 0.00160858012f}, // tal
+	{0x0001d0000c20006eull, 0.00281998306f}, // tan
+	{0x0001d0000c200074ull, 0.00110276893f}, // tat
+	{0x0001d0000ca00064ull, 0.00309607293f}, // ted
+	{0x0001d0000ca0006cull, 0.00121882197f}, // tel
+	{0x0001d0000ca0006eull, 0.00176914665f}, // ten
+	{0x0001d0000ca00072ull, 0.00417870469f}, // ter
+	{0x0001d0000d000061ull, 0.00893158093f}, // tha
+	{0x0001d0000d000065ull, 0.0385107994f}, // the
+	{0x0001d0000d000069ull, 0.00584266195f}, // thi
+	{0x0001d0000d00006full, 0.00274314429f}, // tho
+	{0x0001d0000d000072ull, 0.00118066755f}, // thr
+	{0x0001d0000d200063ull, 0.0010468621f}, // tic
+	{0x0001d0000d20006dull, 0.00157069066f}, // tim
+	{0x0001d0000d20006eull, 0.00334513653f}, // tin
+	{0x0001d0000d20006full, 0.00346357422f}, // tio
+	{0x0001d0000d200074ull, 0.00155452802f}, // tit
+	{0x0001d0000d800065ull, 0.00121776212f}, // tle
+	{0x0001d0000d800079ull, 0.000994664733f}, // tly
+	{0x0001d0000de00062ull, 0.0011748384f}, // tob
+	{0x0001d0000de00066ull, 0.00261145853f}, // tof
+	{0x0001d0000de00068ull, 0.00121935189f}, // toh
+	{0x0001d0000de0006dull, 0.0010927004f}, // tom
+	{0x0001d0000de0006eull, 0.0017222485f}, // ton
+	{0x0001d0000de0006full, 0.00138733734f}, // too
+	{0x0001d0000de00072ull, 0.00177232618f}, // tor
+	{0x0001d0000de00073ull, 0.00120371918f}, // tos
+	{0x0001d0000de00074ull, 0.00239048083f}, // tot
+	{0x0001d0000e400061ull, 0.0017174792f}, // tra
+	{0x0001d0000e400065ull, 0.00115443638f}, // tre
+	{0x0001d0000e600068ull, 0.00104951172f}, // tsh
+	{0x0001d0000e800065ull, 0.00160328089f}, // tte
+	{0x0001d0000e800068ull, 0.00587949157f}, // tth
+	{0x0001d0000e80006full, 0.00200946652f}, // tto
+	{0x0001d0000ea00072ull, 0.00151584367f}, // tur
+	{0x0001d0000ee00061ull, 0.00226700888f}, // twa
+	{0x0001d0000ee0006full, 0.00122783065f}, // two
+	{0x0001d0000f20006full, 0.00153121143f}, // tyo
+	{0x0001d4000ce00068ull, 0.00249620038f}, // ugh
+	{0x0001d4000d800064ull, 0.00374072371f}, // uld
+	{0x0001d4000dc00064ull, 0.00204735599f}, // und
+	{0x0001d4000dc00074ull, 0.000994929695f}, // unt
+	{0x0001d4000e400065ull, 0.00207888638f}, // ure
+	{0x0001d4000e600065ull, 0.0017373513f}, // use
+	{0x0001d4000e600074ull, 0.00178663409f}, // ust
+	{0x0001d4000e800068ull, 0.00125220709f}, // uth
+	{0x0001d4000e800069ull, 0.00117934274f}, // uti
+	{0x0001d4000e800074ull, 0.00142973126f}, // utt
+	{0x0001d8000ca00064ull, 0.000999698997f}, // ved
+	{0x0001d8000ca0006eull, 0.00159904151f}, // ven
+	{0x0001d8000ca00072ull, 0.00432999758f}, // ver
+	{0x0001d8000ca00074ull, 0.00107627281f}, // vet
+	{0x0001dc000c20006eull, 0.00104606722f}, // wan
+	{0x0001dc000c200072ull, 0.00112953002f}, // war
+	{0x0001dc000c200073ull, 0.00731690647f}, // was
+	{0x0001dc000c200079ull, 0.00183591689f}, // way
+	{0x0001dc000ca00072ull, 0.00298770377f}, // wer
+	{0x0001dc000d000061ull, 0.00201900513f}, // wha
+	{0x0001dc000d000065ull, 0.00245645619f}, // whe
+	{0x0001dc000d000069ull, 0.00206272374f}, // whi
+	{0x0001dc000d00006full, 0.0018290279f}, // who
+	{0x0001dc000d20006cull, 0.00111866661f}, // wil
+	{0x0001dc000d200074ull, 0.00368852634f}, // wit
+	{0x0001dc000de00072ull, 0.00157810957f}, // wor
+	{0x0001dc000de00075ull, 0.00194481597f}, // wou
+	{0x0001e4000c20006eull, 0.0010092376f}, // yan
+	{0x0001e4000d20006eull, 0.00126730988f}, // yin
+	{0x0001e4000de00075ull, 0.00774084451f}, // you
+	{0x0001e4000e800068ull, 0.00267372443f}, // yth
 };
 
-CTrigramFrequencyTable_English::CTrigramFrequencyTable_English()
-{
-	static const Trigram trigrams[] = {
-		{"the", 145345ull},
-		{"ing", 54962ull},
-		{"and", 48760ull},
-		{"her", 39506ull},
-		{"tha", 33709ull},
-		{"hat", 32321ull},
-		{"ere", 31635ull},
-		{"you", 29215ull},
-		{"was", 27615ull},
-		{"ent", 26390ull},
-		{"his", 25823ull},
-		{"eth", 25004ull},
-		{"nth", 24324ull},
-		{"she", 22569ull},
-		{"tth", 22190ull},
-		{"thi", 22051ull},
-		{"dth", 21981ull},
-		{"hes", 20915ull},
-		{"for", 20105ull},
-		{"oth", 18827ull},
-		{"had", 18721ull},
-		{"int", 18395ull},
-		{"edt", 17560ull},
-		{"ion", 17456ull},
-		{"est", 17206ull},
-		{"ith", 16984ull},
-		{"ght", 16894ull},
-		{"all", 16803ull},
-		{"rea", 16381ull},
-		{"sth", 16349ull},
-		{"ver", 16342ull},
-		{"not", 16288ull},
-		{"ont", 15955ull},
-		{"ter", 15771ull},
-		{"one", 15730ull},
-		{"ers", 15709ull},
-		{"oul", 15292ull},
-		{"fth", 15047ull},
-		{"oft", 14654ull},
-		{"hen", 14547ull},
-		{"out", 14507ull},
-		{"hin", 14472ull},
-		{"hew", 14388ull},
-		{"uld", 14118ull},
-		{"eve", 14017ull},
-		{"wit", 13921ull},
-		{"ear", 13842ull},
-		{"ome", 13441ull},
-		{"ast", 13147ull},
-		{"ess", 13118ull},
-		{"tio", 13072ull},
-		{"ati", 13026ull},
-		{"our", 12938ull},
-		{"res", 12930ull},
-		{"ewa", 12909ull},
-		{"rth", 12782ull},
-		{"tin", 12625ull},
-		{"hem", 12616ull},
-		{"eda", 12391ull},
-		{"hed", 12322ull},
-		{"sto", 12317ull},
-		{"att", 12292ull},
-		{"igh", 12217ull},
-		{"sta", 12063ull},
-		{"ean", 11947ull},
-		{"ngt", 11809ull},
-		{"ted", 11685ull},
-		{"ant", 11677ull},
-		{"hec", 11602ull},
-		{"ill", 11500ull},
-		{"but", 11484ull},
-		{"edi", 11458ull},
-		{"nce", 11378ull},
-		{"hea", 11337ull},
-		{"wer", 11276ull},
-		{"eto", 11274ull},
-		{"eof", 11257ull},
-		{"ave", 11235ull},
-		{"him", 11145ull},
-		{"ert", 11053ull},
-		{"red", 11028ull},
-		{"ort", 10958ull},
-		{"men", 10951ull},
-		{"dto", 10791ull},
-		{"man", 10755ull},
-		{"ate", 10754ull},
-		{"esa", 10708ull},
-		{"aid", 10691ull},
-		{"eha", 10691ull},
-		{"tan", 10643ull},
-		{"heh", 10580ull},
-		{"now", 10484ull},
-		{"hou", 10441ull},
-		{"ath", 10370ull},
-		{"tho", 10353ull},
-		{"yth", 10091ull},
-		{"sai", 10065ull},
-		{"san", 10039ull},
-		{"din", 10032ull},
-		{"era", 10032ull},
-		{"hey", 9976ull},
-		{"ain", 9964ull},
-		{"sin", 9940ull},
-		{"tof", 9856ull},
-		{"ndt", 9789ull},
-		{"nto", 9743ull},
-		{"are", 9656ull},
-		{"hel", 9633ull},
-		{"eco", 9632ull},
-		{"ive", 9485ull},
-		{"ist", 9484ull},
-		{"ran", 9477ull},
-		{"ugh", 9421ull},
-		{"ore", 9280ull},
-		{"whe", 9271ull},
-		{"don", 9256ull},
-		{"con", 9254ull},
-		{"ard", 9080ull},
-		{"tot", 9022ull},
-		{"ine", 8927ull},
-		{"han", 8923ull},
-		{"eri", 8918ull},
-		{"oun", 8889ull},
-		{"cou", 8874ull},
-		{"het", 8785ull},
-		{"sof", 8711ull},
-		{"ein", 8602ull},
-		{"edo", 8570ull},
-		{"oug", 8568ull},
-		{"nde", 8562ull},
-		{"nin", 8557ull},
-		{"twa", 8556ull},
-		{"eme", 8510ull},
-		{"een", 8477ull},
-		{"der", 8425ull},
-		{"ous", 8350ull},
-		{"ove", 8313ull},
-		{"sti", 8298ull},
-		{"nte", 8288ull},
-		{"eas", 8220ull},
-		{"ehe", 8212ull},
-		{"dan", 8200ull},
-		{"ret", 8119ull},
-		{"art", 8111ull},
-		{"ons", 8068ull},
-		{"hav", 8049ull},
-		{"ste", 8047ull},
-		{"ell", 8037ull},
-		{"nga", 8004ull},
-		{"ure", 7846ull},
-		{"asa", 7836ull},
-		{"ned", 7826ull},
-		{"whi", 7785ull},
-		{"edh", 7775ull},
-		{"hep", 7752ull},
-		{"und", 7727ull},
-		{"lin", 7680ull},
-		{"ind", 7673ull},
-		{"dhe", 7626ull},
-		{"wha", 7620ull},
-		{"son", 7585ull},
-		{"tto", 7584ull},
-		{"nes", 7555ull},
-		{"per", 7478ull},
-		{"nds", 7457ull},
-		{"rin", 7452ull},
-		{"str", 7395ull},
-		{"eat", 7391ull},
-		{"ide", 7376ull},
-		{"wou", 7340ull},
-		{"ose", 7318ull},
-		{"any", 7260ull},
-		{"hef", 7224ull},
-		{"kin", 7217ull},
-		{"com", 7195ull},
-		{"ndi", 7158ull},
-		{"lea", 7099ull},
-		{"ass", 7037ull},
-		{"ame", 6968ull},
-		{"itw", 6966ull},
-		{"way", 6929ull},
-		{"dbe", 6928ull},
-		{"gth", 6920ull},
-		{"who", 6903ull},
-		{"min", 6887ull},
-		{"ead", 6878ull},
-		{"own", 6878ull},
-		{"sho", 6845ull},
-		{"ina", 6840ull},
-		{"ema", 6793ull},
-		{"ked", 6788ull},
-		{"ust", 6743ull},
-		{"hei", 6734ull},
-		{"dno", 6712ull},
-		{"tor", 6689ull},
-		{"ten", 6677ull},
-		{"rou", 6655ull},
-		{"eca", 6652ull},
-		{"led", 6647ull},
-		{"nti", 6607ull},
-		{"ook", 6596ull},
-		{"met", 6594ull},
-		{"cha", 6592ull},
-		{"ene", 6583ull},
-		{"esh", 6577ull},
-		{"fro", 6576ull},
-		{"use", 6557ull},
-		{"den", 6547ull},
-		{"ish", 6529ull},
-		{"eal", 6523ull},
-		{"rom", 6506ull},
-		{"ton", 6500ull},
-		{"tra", 6482ull},
-		{"hth", 6453ull},
-		{"ins", 6432ull},
-		{"pro", 6416ull},
-		{"lly", 6401ull},
-		{"ice", 6394ull},
-		{"ble", 6379ull},
-		{"eno", 6352ull},
-		{"its", 6351ull},
-		{"rst", 6320ull},
-		{"som", 6259ull},
-		{"les", 6257ull},
-		{"lan", 6222ull},
-		{"eso", 6214ull},
-		{"heb", 6183ull},
-		{"end", 6180ull},
-		{"nda", 6169ull},
-		{"eli", 6138ull},
-		{"iti", 6102ull},
-		{"ero", 6099ull},
-		{"dhi", 6084ull},
-		{"sed", 6084ull},
-		{"sha", 6075ull},
-		{"tal", 6071ull},
-		{"ona", 6054ull},
-		{"tte", 6051ull},
-		{"kno", 6043ull},
-		{"ven", 6035ull},
-		{"ect", 6014ull},
-		{"ese", 5990ull},
-		{"anc", 5976ull},
-		{"ewh", 5972ull},
-		{"enc", 5971ull},
-		{"ofa", 5966ull},
-		{"ime", 5958ull},
-		{"wor", 5956ull},
-		{"tim", 5928ull},
-		{"tit", 5867ull},
-		{"efo", 5854ull},
-		{"did", 5851ull},
-		{"ake", 5825ull},
-		{"nan", 5806ull},
-		{"esi", 5798ull},
-		{"tyo", 5779ull},
-		{"ngs", 5762ull},
-		{"nge", 5753ull},
-		{"old", 5747ull},
-		{"ens", 5727ull},
-		{"asi", 5726ull},
-		{"tur", 5721ull},
-		{"ich", 5718ull},
-		{"let", 5707ull},
-		{"ile", 5686ull},
-		{"ngi", 5680ull},
-		{"swe", 5670ull},
-		{"ans", 5653ull},
-		{"sno", 5631ull},
-		{"ewo", 5571ull},
-		{"new", 5555ull},
-		{"ssi", 5551ull},
-		{"ena", 5528ull},
-		{"itt", 5473ull},
-		{"see", 5473ull},
-		{"rew", 5453ull},
-		{"ery", 5429ull},
-		{"loo", 5405ull},
-		{"utt", 5396ull},
-		{"abo", 5389ull},
-		{"eit", 5377ull},
-		{"ndo", 5362ull},
-		{"mor", 5302ull},
-		{"dit", 5293ull},
-		{"lth", 5266ull},
-		{"too", 5236ull},
-		{"can", 5228ull},
-		{"erh", 5227ull},
-		{"eyo", 5227ull},
-		{"emo", 5203ull},
-		{"nhe", 5201ull},
-		{"pre", 5201ull},
-		{"sel", 5183ull},
-		{"ren", 5052ull},
-		{"how", 5047ull},
-		{"ace", 5038ull},
-		{"ded", 5016ull},
-		{"ora", 5013ull},
-		{"nta", 5011ull},
-		{"ree", 5007ull},
-		{"ats", 5005ull},
-		{"lli", 4996ull},
-		{"ade", 4987ull},
-		{"sen", 4897ull},
-		{"ica", 4867ull},
-		{"sse", 4865ull},
-		{"ana", 4852ull},
-		{"mea", 4848ull},
-		{"eni", 4839ull},
-		{"ali", 4838ull},
-		{"ack", 4829ull},
-		{"nst", 4823ull},
-		{"ood", 4816ull},
-		{"off", 4811ull},
-		{"yin", 4783ull},
-		{"heo", 4769ull},
-		{"ang", 4765ull},
-		{"bee", 4762ull},
-		{"ike", 4750ull},
-		{"ash", 4745ull},
-		{"ofh", 4744ull},
-		{"lit", 4731ull},
-		{"mil", 4726ull},
-		{"uth", 4726ull},
-		{"ite", 4709ull},
-		{"ong", 4709ull},
-		{"che", 4700ull},
-		{"get", 4700ull},
-		{"age", 4683ull},
-		{"ndh", 4657ull},
-		{"sit", 4657ull},
-		{"rie", 4648ull},
-		{"ani", 4638ull},
-		{"ono", 4638ull},
-		{"lle", 4634ull},
-		{"two", 4634ull},
-		{"nts", 4623ull},
-		{"spe", 4619ull},
-		{"ewi", 4618ull},
-		{"mth", 4609ull},
-		{"hee", 4607ull},
-		{"toh", 4602ull},
-		{"tel", 4600ull},
-		{"eon", 4597ull},
-		{"tle", 4596ull},
-		{"ple", 4585ull},
-		{"ity", 4582ull},
-		{"rec", 4581ull},
-		{"rat", 4572ull},
-		{"dis", 4557ull},
-		{"tos", 4543ull},
-		{"ebe", 4537ull},
-		{"hic", 4533ull},
-		{"heg", 4529ull},
-		{"bou", 4519ull},
-		{"iss", 4519ull},
-		{"ett", 4518ull},
-		{"cti", 4497ull},
-		{"ntt", 4491ull},
-		{"ngh", 4484ull},
-		{"ede", 4479ull},
-		{"thr", 4456ull},
-		{"uti", 4451ull},
-		{"tob", 4434ull},
-		{"lik", 4433ull},
-		{"ost", 4418ull},
-		{"rde", 4405ull},
-		{"dre", 4400ull},
-		{"oin", 4398ull},
-		{"gin", 4389ull},
-		{"erw", 4387ull},
-		{"nal", 4387ull},
-		{"chi", 4383ull},
-		{"sco", 4383ull},
-		{"eir", 4362ull},
-		{"tre", 4357ull},
-		{"ehi", 4352ull},
-		{"edw", 4310ull},
-		{"pla", 4305ull},
-		{"fac", 4274ull},
-		{"edb", 4271ull},
-		{"war", 4263ull},
-		{"ele", 4257ull},
-		{"sst", 4252ull},
-		{"nat", 4250ull},
-		{"ngo", 4225ull},
-		{"wil", 4222ull},
-		{"rto", 4215ull},
-		{"dof", 4212ull},
-		{"ewe", 4209ull},
-		{"gto", 4206ull},
-		{"obe", 4198ull},
-		{"lon", 4197ull},
-		{"sid", 4182ull},
-		{"tat", 4162ull},
-		{"llt", 4161ull},
-		{"rem", 4158ull},
-		{"isa", 4157ull},
-		{"air", 4142ull},
-		{"mon", 4141ull},
-		{"act", 4137ull},
-		{"tom", 4124ull},
-		{"ord", 4121ull},
-		{"par", 4121ull},
-		{"ise", 4090ull},
-		{"des", 4076ull},
-		{"inc", 4070ull},
-		{"llo", 4065ull},
-		{"vet", 4062ull},
-		{"oni", 4040ull},
-		{"abl", 4016ull},
-		{"cal", 4008ull},
-		{"ita", 3994ull},
-		{"dow", 3989ull},
-		{"eds", 3989ull},
-		{"ach", 3988ull},
-		{"app", 3987ull},
-		{"shi", 3979ull},
-		{"eta", 3965ull},
-		{"rit", 3961ull},
-		{"tsh", 3961ull},
-		{"tic", 3951ull},
-		{"wan", 3948ull},
-		{"owe", 3946ull},
-		{"ppe", 3939ull},
-		{"har", 3936ull},
-		{"ela", 3926ull},
-		{"swh", 3925ull},
-		{"rse", 3913ull},
-		{"ays", 3905ull},
-		{"med", 3904ull},
-		{"nly", 3899ull},
-		{"oss", 3895ull},
-		{"car", 3882ull},
-		{"gre", 3870ull},
-		{"ire", 3836ull},
-		{"elo", 3828ull},
-		{"ase", 3821ull},
-		{"eti", 3817ull},
-		{"ndw", 3813ull},
-		{"epr", 3810ull},
-		{"mes", 3810ull},
-		{"yan", 3809ull},
-		{"ved", 3773ull},
-		{"low", 3772ull},
-		{"oma", 3768ull},
-		{"nhi", 3763ull},
-		{"lyt", 3756ull},
-		{"unt", 3755ull},
-		{"tly", 3754ull},
-		{"ond", 3749ull},
-		{"dea", 3722ull},
-		{nullptr, 0},
-	};
-
-	_table.totalTrigramsCount = 3774136ull;
+static_assert(CTrigramFrequencyTable_Base::isSorted(trigrams), "The trigrams must be sorted for binary search");
 
-	for (quint64 i = 0; trigrams[i].trigram != nullptr; ++i)
-		_table.trigramOccurrenceTable[QString::fromUtf8(trigrams[i].trigram)] = trigrams[i].count;
+CTrigramFrequencyTable_English::CTrigramFrequencyTable_English() : CTrigramFrequencyTable_Base(trigrams)
+{
 }
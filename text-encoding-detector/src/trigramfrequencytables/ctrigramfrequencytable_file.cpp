@@ -0,0 +1,97 @@
+#include "ctrigramfrequencytable_file.h"
+
+DISABLE_COMPILER_WARNINGS
+#include <QFile>
+RESTORE_COMPILER_WARNINGS
+
+#include <stddef.h>
+#include <string.h>
+
+// The entries are used in place, so their layout is part of the format
+static_assert(sizeof(CTrigramFrequencyTable_Base::Entry) == 16 && alignof(CTrigramFrequencyTable_Base::Entry) == 8, "The binary model format relies on this Entry layout");
+static_assert(sizeof(CTrigramFrequencyTable_File::Header) == 32, "The binary model format relies on this Header layout");
+
+static constexpr quint32 alignedToEntry(const quint32 offset)
+{
+	return (offset + alignof(CTrigramFrequencyTable_Base::Entry) - 1) & ~quint32{alignof(CTrigramFrequencyTable_Base::Entry) - 1};
+}
+
+CTrigramFrequencyTable_File::CTrigramFrequencyTable_File(std::unique_ptr<QFile> file, const Entry* entries, size_t size, QString language) :
+	CTrigramFrequencyTable_Base(entries, size),
+	_file(std::move(file)),
+	_language(std::move(language))
+{
+}
+
+CTrigramFrequencyTable_File::~CTrigramFrequencyTable_File() = default;
+
+std::unique_ptr<CTrigramFrequencyTable_File> CTrigramFrequencyTable_File::load(const QString& filePath)
+{
+	auto file = std::make_unique<QFile>(filePath);
+	if (!file->open(QFile::ReadOnly))
+		return nullptr;
+
+	const qint64 fileSize = file->size();
+	if (fileSize < (qint64)sizeof(Header))
+		return nullptr;
+
+	// The mapping is page-aligned, so are the entries as long as their offset is a multiple of the Entry alignment
+	const uchar* data = file->map(0, fileSize);
+	if (!data)
+		return nullptr;
+
+	Header header;
+	::memcpy(&header, data, sizeof(Header));
+	if (::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != currentVersion || header.byteOrderMark != byteOrderMark)
+		return nullptr;
+
+	const quint64 entriesOffset = header.entriesOffset;
+	if (entriesOffset < sizeof(Header) + (quint64)header.languageNameSize || entriesOffset > (quint64)fileSize || entriesOffset % alignof(Entry) != 0)
+		return nullptr;
+
+	if (header.numEntries > ((quint64)fileSize - entriesOffset) / sizeof(Entry))
+		return nullptr;
+
+	const auto* entries = reinterpret_cast<const Entry*>(data + entriesOffset);
+	const size_t numEntries = (size_t)header.numEntries;
+	// The only pass over the entries: a file that isn't sorted would silently break the binary search
+	for (size_t i = 1; i < numEntries; ++i)
+	{
+		if (!(entries[i - 1].trigram < entries[i].trigram))
+			return nullptr;
+	}
+
+	QString language = QString::fromUtf8(reinterpret_cast<const char*>(data + sizeof(Header)), (qsizetype)header.languageNameSize);
+	return std::unique_ptr<CTrigramFrequencyTable_File>(new CTrigramFrequencyTable_File(std::move(file), entries, numEntries, std::move(language)));
+}
+
+bool CTrigramFrequencyTable_File::save(const QString& filePath, const QString& language, const std::vector<Entry>& entries)
+{
+	const QByteArray languageName = language.toUtf8();
+
+	Header header;
+	::memcpy(header.magic, magic, sizeof(magic));
+	header.version = currentVersion;
+	header.byteOrderMark = byteOrderMark;
+	header.numEntries = entries.size();
+	header.languageNameSize = (quint32)languageName.size();
+	header.entriesOffset = alignedToEntry((quint32)sizeof(Header) + header.languageNameSize);
+
+	QFile file(filePath);
+	if (!file.open(QFile::WriteOnly))
+		return false;
+
+	QByteArray contents(reinterpret_cast<const char*>(&header), sizeof(Header));
+	contents.append(languageName);
+	contents.append(QByteArray((qsizetype)header.entriesOffset - contents.size(), '\0'));
+	for (const Entry& entry: entries)
+	{
+		// Zeroing the padding, so that the same table always produces the same file
+		char entryBytes[sizeof(Entry)] = {};
+		::memcpy(entryBytes, &entry.trigram, sizeof(entry.trigram));
+		::memcpy(entryBytes + offsetof(Entry, frequency), &entry.frequency, sizeof(entry.frequency));
+		contents.append(entryBytes, (qsizetype)sizeof(Entry));
+	}
+
+	return file.write(contents) == contents.size() && file.flush();
+}
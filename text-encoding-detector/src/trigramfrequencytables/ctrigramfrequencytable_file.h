@@ -0,0 +1,47 @@
+#pragma once
+
+#include "ctrigramfrequencytable_base.h"
+
+#include <memory>
+#include <vector>
+
+class QFile;
+
+// A table loaded from a binary model file written by text_analyzer --binary, so that languages can be added without rebuilding.
+// The file is memory-mapped read-only and the entries are used in place: loading doesn't parse or copy anything, and the pages are shared by all the processes using the same file.
+//
+// File format, in the native byte order (checked when loading):
+// Header, the language name in UTF-8, padding to a multiple of 8 bytes, then Header::numEntries Entry structures sorted by the trigram.
+class CTrigramFrequencyTable_File final : public CTrigramFrequencyTable_Base
+{
+public:
+	struct Header
+	{
+		char magic[8]; // "TEDTRIGR"
+		quint32 version;
+		quint32 byteOrderMark; // 0x01020304 as written by the machine that created the file
+		quint64 numEntries;
+		quint32 languageNameSize; // In bytes
+		quint32 entriesOffset; // From the start of the file
+	};
+
+	static constexpr char magic[8] = {'T', 'E', 'D', 'T', 'R', 'I', 'G', 'R'};
+	static constexpr quint32 currentVersion = 1;
+	static constexpr quint32 byteOrderMark = 0x01020304;
+
+	~CTrigramFrequencyTable_File() override;
+
+	// Returns nullptr if the file can't be mapped, or if it's not a valid model file of the current version
+	[[nodiscard]] static std::unique_ptr<CTrigramFrequencyTable_File> load(const QString& filePath);
+	// The entries must be sorted by the trigram
+	static bool save(const QString& filePath, const QString& language, const std::vector<Entry>& entries);
+
+	[[nodiscard]] inline QString language() const override {return _language;}
+
+private:
+	CTrigramFrequencyTable_File(std::unique_ptr<QFile> file, const Entry* entries, size_t size, QString language);
+
+private:
+	std::unique_ptr<QFile> _file; // Keeps the mapping alive
+	const QString _language;
+};
@@ -1,425 +1,417 @@
 #include "ctrigramfrequencytable_russian.h"
 
-
-struct Trigram {
-	const char * trigram;
-	quint64 count;
+// Sorted by the packed trigram value, see CTextParser::packTrigram()
+static constexpr CTrigramFrequencyTable_Base::Entry trigrams[] = {
+	{0x0010c00086400438ull, 0.00175926392f}, // ави
+	{0x0010c0008640043bull, 0.00138662965f}, // авл
+	{0x0010c0008660043eull, 0.00144515233f}, // аго
+	{0x0010c0008680043eull, 0.00170074124f}, // адо
+	{0x0010c00086a00442ull, 0.00197663391f}, // ает
+	{0x0010c00086c00435ull, 0.00226865034f}, // аже
+	{0x0010c00086e00430ull, 0.00614249427f}, // аза
+	{0x0010c00087400430ull, 0.00179987145f}, // ака
+	{0x0010c00087400438ull, 0.00198141136f}, // аки
+	{0x0010c0008740043eull, 0.0042685736f}, // ако
+	{0x0010c00087600430ull, 0.00430977857f}, // ала
+	{0x0010c00087600435ull, 0.00276012137f}, // але
+	{0x0010c00087600438ull, 0.00455043837f}, // али
+	{0x0010c0008760043eull, 0.00324323238f}, // ало
+	{0x0010c00087600441ull, 0.00205068314f}, // алс
+	{0x0010c0008760044cull, 0.00158130715f}, // аль
+	{0x0010c00087800435ull, 0.00146187306f}, // аме
+	{0x0010c00087800438ull, 0.0031142435f}, // ами
+	{0x0010c0008780043eull, 0.00167804875f}, // амо
+	{0x0010c00087a00430ull, 0.00244600978f}, // ана
+	{0x0010c00087a00434ull, 0.00155742036f}, // анд
+	{0x0010c00087a00435ull, 0.00297151972f}, // ане
+	{0x0010c00087a00438ull, 0.00320919347f}, // ани
+	{0x0010c00087a0043dull, 0.00191333389f}, // анн
+	{0x0010c00087a0043eull, 0.00191213947f}, // ано
+	{0x0010c00087c0043dull, 0.00140275317f}, // аон
+	{0x0010c00087e0043eull, 0.00284372526f}, // апо
+	{0x0010c00087e00440ull, 0.00192945742f}, // апр
+	{0x0010c00088000430ull, 0.00144515233f}, // ара
+	{0x0010c00088000438ull, 0.00142843148f}, // ари
+	{0x0010c00088200441ull, 0.00144097209f}, // асс
+	{0x0010c00088200442ull, 0.00331548997f}, // аст
+	{0x0010c0008820044cull, 0.00166491093f}, // ась
+	{0x0010c00088400430ull, 0.00201664423f}, // ата
+	{0x0010c00088400435ull, 0.00182196684f}, // ате
+	{0x0010c0008840043eull, 0.00229432853f}, // ато
+	{0x0010c0008840044cull, 0.00573104387f}, // ать
+	{0x0010c00089e00441ull, 0.00149710616f}, // аяс
+	{0x0010c40087c0043bull, 0.00198379997f}, // бол
+	{0x0010c40088000430ull, 0.00200888119f}, // бра
+	{0x0010c40088600434ull, 0.00207158411f}, // буд
+	{0x0010c4008960043bull, 0.00575075066f}, // был
+	{0x0010c40089600442ull, 0.00142066833f}, // быт
+	{0x0010c8008600043bull, 0.00396640552f}, // вал
+	{0x0010c8008600043dull, 0.00212771795f}, // ван
+	{0x0010c80086000442ull, 0.00204172544f}, // ват
+	{0x0010c80086a0043dull, 0.00160399964f}, // вен
+	{0x0010c80086a00440ull, 0.00368036097f}, // вер
+	{0x0010c80086a00441ull, 0.00172641955f}, // вес
+	{0x0010c80086a00442ull, 0.00140275317f}, // вет
+	{0x0010c80087000434ull, 0.00261620339f}, // вид
+	{0x0010c8008700043bull, 0.00147381646f}, // вил
+	{0x0010c80087a0043eull, 0.00139857305f}, // вно
+	{0x0010c80087c00432ull, 0.00151024386f}, // вов
+	{0x0010c80087c00435ull, 0.0020488915f}, // вое
+	{0x0010c80087c00437ull, 0.00132989837f}, // воз
+	{0x0010c80087c00439ull, 0.00156518351f}, // вой
+	{0x0010c80087c0043bull, 0.00161952607f}, // вол
+	{0x0010c80087c00440ull, 0.00424050679f}, // вор
+	{0x0010c80087c00441ull, 0.0014296259f}, // вос
+	{0x0010c80087c00442ull, 0.00155562884f}, // вот
+	{0x0010c80088200435ull, 0.00556562794f}, // все
+	{0x0010c80088200442ull, 0.00198618858f}, // вст
+	{0x0010c80089000438ull, 0.00195871876f}, // вши
+	{0x0010cc0086800430ull, 0.00275653834f}, // гда
+	{0x0010cc0087600430ull, 0.00193542917f}, // гла
+	{0x0010cc0087c00432ull, 0.00474332413f}, // гов
+	{0x0010cc0087c00434ull, 0.00160340243f}, // год
+	{0x0010cc0087c0043bull, 0.00187690649f}, // гол
+	{0x0010cc0087c0043dull, 0.00202799053f}, // гон
+	{0x0010cc0087c0043full, 0.00139260129f}, // гоп
+	{0x0010cc0087c00440ull, 0.00201485283f}, // гор
+	{0x0010cc0087c00441ull, 0.00295479898f}, // гос
+	{0x0010cc0088000430ull, 0.00163326098f}, // гра
+	{0x0010d00086000432ull, 0.00163326098f}, // дав
+	{0x0010d0008600043bull, 0.00171746197f}, // дал
+	{0x0010d0008600043dull, 0.00162788644f}, // дан
+	{0x0010d00086000442ull, 0.00134243898f}, // дат
+	{0x0010d00086a0043bull, 0.00368872145f}, // дел
+	{0x0010d00086a0043dull, 0.00203396217f}, // ден
+	{0x0010d00086a00442ull, 0.00198559137f}, // дет
+	{0x0010d0008700043dull, 0.00141947402f}, // дин
+	{0x0010d00087000442ull, 0.00148157973f}, // дит
+	{0x0010d00087a0043eull, 0.00197961973f}, // дно
+	{0x0010d00087c0043bull, 0.00160997128f}, // дол
+	{0x0010d00087c0043cull, 0.00135557668f}, // дом
+	{0x0010d00087c00440ull, 0.00142843148f}, // дор
+	{0x0010d00088000443ull, 0.00280072913f}, // дру
+	{0x0010d0008860043cull, 0.00131556636f}, // дум
+	{0x0010d40086200435ull, 0.00165057892f}, // ебе
+	{0x0010d4008620044full, 0.00134841073f}, // ебя
+	{0x0010d4008640043eull, 0.00152756181f}, // ево
+	{0x0010d4008660043eull, 0.00965982769f}, // его
+	{0x0010d4008680043eull, 0.00191811123f}, // едо
+	{0x0010d40086e00430ull, 0.00131258043f}, // еза
+	{0x0010d40087400430ull, 0.00154368544f}, // ека
+	{0x0010d40087600430ull, 0.00279714609f}, // ела
+	{0x0010d40087600435ull, 0.00140155887f}, // еле
+	{0x0010d40087600438ull, 0.00289209606f}, // ели
+	{0x0010d4008760043eull, 0.00312021514f}, // ело
+	{0x0010d4008760044cull, 0.00331011531f}, // ель
+	{0x0010d40087800435ull, 0.00135139655f}, // еме
+	{0x0010d4008780043eull, 0.00200649234f}, // емо
+	{0x0010d40087800443ull, 0.00329100597f}, // ему
+	{0x0010d40087a00430ull, 0.00222027954f}, // ена
+	{0x0010d40087a00435ull, 0.00258216471f}, // ене
+	{0x0010d40087a00438ull, 0.00686208485f}, // ени
+	{0x0010d40087a0043dull, 0.00530466437f}, // енн
+	{0x0010d40087a0044cull, 0.00256484677f}, // ень
+	{0x0010d40087a0044full, 0.0013931985f}, // еня
+	{0x0010d40087e00435ull, 0.00177359604f}, // епе
+	{0x0010d40087e0043eull, 0.00301571027f}, // епо
+	{0x0010d40087e00440ull, 0.00245795329f}, // епр
+	{0x0010d40088000430ull, 0.002376738f}, // ера
+	{0x0010d40088000435ull, 0.00414316822f}, // ере
+	{0x0010d4008800043dull, 0.00140753051f}, // ерн
+	{0x0010d4008800044cull, 0.00165774499f}, // ерь
+	{0x0010d4008820043aull, 0.00183629885f}, // еск
+	{0x0010d4008820043bull, 0.00142843148f}, // есл
+	{0x0010d40088200442ull, 0.00591915287f}, // ест
+	{0x0010d40088400435ull, 0.0021940039f}, // ете
+	{0x0010d40088400438ull, 0.00148755137f}, // ети
+	{0x0010d4008840043eull, 0.0018792951f}, // ето
+	{0x0010d40088400441ull, 0.00172582234f}, // етс
+	{0x0010d40089200435ull, 0.00160519395f}, // еще
+	{0x0010d8008600043bull, 0.00178971956f}, // жал
+	{0x0010d80086a0043dull, 0.0035740647f}, // жен
+	{0x0010d80086a00442ull, 0.00134064746f}, // жет
+	{0x0010d80087a0043eull, 0.00134124467f}, // жно
+	{0x0010dc008600043bull, 0.00334236259f}, // зал
+	{0x0010dc0087a00430ull, 0.00329399179f}, // зна
+	{0x0010e00086400430ull, 0.00327309081f}, // ива
+	{0x0010e0008640043eull, 0.00191751402f}, // иво
+	{0x0010e00086400441ull, 0.00133407861f}, // ивс
+	{0x0010e00086800430ull, 0.00145052688f}, // ида
+	{0x0010e00086800435ull, 0.0020841246f}, // иде
+	{0x0010e00086a0043cull, 0.00128749933f}, // ием
+	{0x0010e00086e0043dull, 0.0013812551f}, // изн
+	{0x0010e00087400430ull, 0.00241973437f}, // ика
+	{0x0010e0008740043eull, 0.00283058756f}, // ико
+	{0x0010e00087600430ull, 0.00269861287f}, // ила
+	{0x0010e00087600438ull, 0.00366244582f}, // или
+	{0x0010e0008760043eull, 0.00190915365f}, // ило
+	{0x0010e00087600441ull, 0.00209666509f}, // илс
+	{0x0010e00087800430ull, 0.00158548728f}, // има
+	{0x0010e00087800435ull, 0.00146784482f}, // име
+	{0x0010e00087800438ull, 0.00149292592f}, // ими
+	{0x0010e0008780043eull, 0.00156458642f}, // имо
+	{0x0010e00087a00430ull, 0.00341820321f}, // ина
+	{0x0010e00087a00435ull, 0.0032348719f}, // ине
+	{0x0010e00087a0043eull, 0.00153054763f}, // ино
+	{0x0010e00087a00443ull, 0.00144634664f}, // ину
+	{0x0010e00087c0043dull, 0.00131616346f}, // ион
+	{0x0010e00087e0043eull, 0.00294942455f}, // ипо
+	{0x0010e00087e00440ull, 0.00201843586f}, // ипр
+	{0x0010e00088000430ull, 0.00137528335f}, // ира
+	{0x0010e00088200442ull, 0.00256663817f}, // ист
+	{0x0010e0008820044cull, 0.00267174025f}, // ись
+	{0x0010e00088400430ull, 0.0016350525f}, // ита
+	{0x0010e00088400435ull, 0.00345821353f}, // ите
+	{0x0010e0008840043eull, 0.00143679185f}, // ито
+	{0x0010e0008840044cull, 0.00364035065f}, // ить
+	{0x0010e00088e00435ull, 0.00176642998f}, // иче
+	{0x0010e40088200442ull, 0.00130541448f}, // йст
+	{0x0010e80086000437ull, 0.00495591667f}, // каз
+	{0x0010e8008600043aull, 0.00658858055f}, // как
+	{0x0010e80087a0044full, 0.0018894471f}, // кня
+	{0x0010e80087c00432ull, 0.00212771795f}, // ков
+	{0x0010e80087c00433ull, 0.0029201631f}, // ког
+	{0x0010e80087c00439ull, 0.0022776078f}, // кой
+	{0x0010e80087c0043bull, 0.00235285121f}, // кол
+	{0x0010e80087c0043cull, 0.00303541706f}, // ком
+	{0x0010e80087c0043dull, 0.00255051465f}, // кон
+	{0x0010e80087c00442ull, 0.0036708063f}, // кот
+	{0x0010e8008840043eull, 0.00151203538f}, // кто
+	{0x0010ec0086000432ull, 0.00167088269f}, // лав
+	{0x0010ec008600043dull, 0.00158250146f}, // лан
+	{0x0010ec0086000441ull, 0.00279416004f}, // лас
+	{0x0010ec0086000442ull, 0.00130183145f}, // лат
+	{0x0010ec0086a0043dull, 0.00324502378f}, // лен
+	{0x0010ec0087000432ull, 0.00225610961f}, // лив
+	{0x0010ec008700043dull, 0.00131676067f}, // лин
+	{0x0010ec0087000441ull, 0.00266278256f}, // лис
+	{0x0010ec0087000446ull, 0.00151740992f}, // лиц
+	{0x0010ec0087c00432ull, 0.00475586485f}, // лов
+	{0x0010ec0087c0043dull, 0.002229237f}, // лон
+	{0x0010ec0087c00441ull, 0.00312140957f}, // лос
+	{0x0010ec008820044full, 0.00395446224f}, // лся
+	{0x0010ec008980043aull, 0.00268846098f}, // льк
+	{0x0010ec008980043dull, 0.00348448916f}, // льн
+	{0x0010ec0089c00431ull, 0.00134243898f}, // люб
+	{0x0010f0008600043bull, 0.00197961973f}, // мал
+	{0x0010f00086a0043dull, 0.00316082267f}, // мен
+	{0x0010f0008700043dull, 0.00157055806f}, // мин
+	{0x0010f00087000442ull, 0.00129466539f}, // мит
+	{0x0010f00087a00435ull, 0.0023134381f}, // мне
+	{0x0010f00087c00433ull, 0.00160877698f}, // мог
+	{0x0010f00087c00436ull, 0.00145590131f}, // мож
+	{0x0010f00087c0043bull, 0.00145291549f}, // мол
+	{0x0010f00087c00442ull, 0.00152159005f}, // мот
+	{0x0010f40086000432ull, 0.00183211872f}, // нав
+	{0x0010f40086000434ull, 0.00227342756f}, // над
+	{0x0010f4008600043aull, 0.00186197716f}, // нак
+	{0x0010f4008600043bull, 0.00138722674f}, // нал
+	{0x0010f4008600043cull, 0.00158966752f}, // нам
+	{0x0010f4008600043dull, 0.00173776574f}, // нан
+	{0x0010f4008600043full, 0.00262336945f}, // нап
+	{0x0010f40086000441ull, 0.00265561673f}, // нас
+	{0x0010f40086000442ull, 0.00268607237f}, // нат
+	{0x0010f40086000447ull, 0.00168820063f}, // нач
+	{0x0010f40086a00432ull, 0.00192109705f}, // нев
+	{0x0010f40086a00433ull, 0.0018177866f}, // нег
+	{0x0010f40086a0043cull, 0.00228178804f}, // нем
+	{0x0010f40086a0043dull, 0.00181300926f}, // нен
+	{0x0010f40086a0043eull, 0.00138364371f}, // нео
+	{0x0010f40086a0043full, 0.0024973664f}, // неп
+	{0x0010f40086a00441ull, 0.0028962763f}, // нес
+	{0x0010f40086a00442ull, 0.00211338582f}, // нет
+	{0x0010f40087000435ull, 0.00335430587f}, // ние
+	{0x0010f4008700043aull, 0.00312081235f}, // ник
+	{0x0010f4008700043cull, 0.00222684839f}, // ним
+	{0x0010f4008700044full, 0.00256544398f}, // ния
+	{0x0010f40087a0043eull, 0.00428230874f}, // нно
+	{0x0010f40087a0044bull, 0.00244660699f}, // нны
+	{0x0010f40087c00432ull, 0.00399865257f}, // нов
+	{0x0010f40087c00433ull, 0.00278281397f}, // ног
+	{0x0010f40087c00435ull, 0.0017329884f}, // ное
+	{0x0010f40087c00439ull, 0.00204291986f}, // ной
+	{0x0010f40087c0043cull, 0.00177240162f}, // ном
+	{0x0010f40087c0043dull, 0.00130302575f}, // нон
+	{0x0010f40087c0043full, 0.00154308823f}, // ноп
+	{0x0010f40087c00441ull, 0.00354301184f}, // нос
+	{0x0010f4008860043bull, 0.0025069213f}, // нул
+	{0x0010f40089600435ull, 0.00137468614f}, // ные
+	{0x0010f40089600439ull, 0.00198439718f}, // ный
+	{0x0010f4008960043cull, 0.00218385202f}, // ным
+	{0x0010f40089e00437ull, 0.00131676067f}, // няз
+	{0x0010f80086200435ull, 0.00161295722f}, // обе
+	{0x0010f8008620043eull, 0.00182973f}, // обо
+	{0x0010f80086200440ull, 0.00194856687f}, // обр
+	{0x0010f8008620044bull, 0.00358123076f}, // обы
+	{0x0010f80086400430ull, 0.00441906089f}, // ова
+	{0x0010f80086400435ull, 0.00397357158f}, // ове
+	{0x0010f80086400438ull, 0.00287537533f}, // ови
+	{0x0010f8008640043dull, 0.00142007112f}, // овн
+	{0x0010f8008640043eull, 0.00616100663f}, // ово
+	{0x0010f80086400441ull, 0.00276788464f}, // овс
+	{0x0010f8008640044bull, 0.00166610535f}, // овы
+	{0x0010f80086600434ull, 0.0023988334f}, // огд
+	{0x0010f8008660043eull, 0.0082337847f}, // ого
+	{0x0010f80086800430ull, 0.00157593261f}, // ода
+	{0x0010f80086800435ull, 0.001454707f}, // оде
+	{0x0010f80086800438ull, 0.00284133665f}, // оди
+	{0x0010f8008680043dull, 0.0029577848f}, // одн
+	{0x0010f8008680043eull, 0.00232717302f}, // одо
+	{0x0010f80086c00435ull, 0.00281924126f}, // оже
+	{0x0010f80086c00438ull, 0.00138364371f}, // ожи
+	{0x0010f80086e00430ull, 0.00133527291f}, // оза
+	{0x0010f80087200441ull, 0.00138364371f}, // ойс
+	{0x0010f80087400430ull, 0.00217788038f}, // ока
+	{0x0010f8008740043eull, 0.00239525037f}, // око
+	{0x0010f80087600435ull, 0.00212353794f}, // оле
+	{0x0010f80087600438ull, 0.00131496915f}, // оли
+	{0x0010f8008760043eull, 0.00366722327f}, // оло
+	{0x0010f8008760044cull, 0.00492187822f}, // оль
+	{0x0010f80087800438ull, 0.00146545609f}, // оми
+	{0x0010f8008780043dull, 0.00236778054f}, // омн
+	{0x0010f8008780043eull, 0.00173537713f}, // омо
+	{0x0010f80087800443ull, 0.00270279311f}, // ому
+	{0x0010f80087a00430ull, 0.00518463319f}, // она
+	{0x0010f80087a00435ull, 0.00427155942f}, // оне
+	{0x0010f80087a00438ull, 0.00294046686f}, // они
+	{0x0010f80087a0043eull, 0.00170253275f}, // оно
+	{0x0010f80087c0043dull, 0.00231821532f}, // оон
+	{0x0010f80087e0043eull, 0.00317455758f}, // опо
+	{0x0010f80087e00440ull, 0.00322651141f}, // опр
+	{0x0010f80088000430ull, 0.00218683784f}, // ора
+	{0x0010f80088000438ull, 0.00363079575f}, // ори
+	{0x0010f8008800043eull, 0.00586719904f}, // оро
+	{0x0010f8008800044bull, 0.001696561f}, // оры
+	{0x0010f80088200438ull, 0.00177777617f}, // оси
+	{0x0010f8008820043aull, 0.00211756607f}, // оск
+	{0x0010f8008820043bull, 0.00212413492f}, // осл
+	{0x0010f8008820043eull, 0.00179210829f}, // осо
+	{0x0010f80088200442ull, 0.0088058738f}, // ост
+	{0x0010f8008820044cull, 0.00165595347f}, // ось
+	{0x0010f80088400430ull, 0.0013448277f}, // ота
+	{0x0010f80088400432ull, 0.00167745154f}, // отв
+	{0x0010f80088400435ull, 0.00171208743f}, // оте
+	{0x0010f8008840043eull, 0.00759242428f}, // ото
+	{0x0010f80088400440ull, 0.00190377911f}, // отр
+	{0x0010f80088e00435ull, 0.00254095998f}, // оче
+	{0x0010f80088e00442ull, 0.00257201283f}, // очт
+	{0x0010fc0086a00440ull, 0.00466031767f}, // пер
+	{0x0010fc0087c00434ull, 0.00452714879f}, // под
+	{0x0010fc0087c0043aull, 0.0019378179f}, // пок
+	{0x0010fc0087c0043bull, 0.00336386077f}, // пол
+	{0x0010fc0087c0043cull, 0.00143858336f}, // пом
+	{0x0010fc0087c00441ull, 0.00322292838f}, // пос
+	{0x0010fc0087c00442ull, 0.00185839413f}, // пот
+	{0x0010fc0088000430ull, 0.00182674418f}, // пра
+	{0x0010fc0088000435ull, 0.00351912505f}, // пре
+	{0x0010fc0088000438ull, 0.00618967088f}, // при
+	{0x0010fc008800043eull, 0.00728547852f}, // про
+	{0x0010fc0089800435ull, 0.00133825885f}, // пье
+	{0x0011000086000432ull, 0.00225730403f}, // рав
+	{0x0011000086000437ull, 0.00392281218f}, // раз
+	{0x001100008600043dull, 0.00214981334f}, // ран
+	{0x0011000086000441ull, 0.00298525463f}, // рас
+	{0x0011000086000442ull, 0.0019396093f}, // рат
+	{0x0011000086a00434ull, 0.00331548997f}, // ред
+	{0x0011000086a0043cull, 0.00165057892f}, // рем
+	{0x001100008700043aull, 0.00137289462f}, // рик
+	{0x001100008700043bull, 0.0022889541f}, // рил
+	{0x0011000087000442ull, 0.00189183571f}, // рит
+	{0x0011000087c00432ull, 0.00239286176f}, // ров
+	{0x0011000087c00433ull, 0.00152756181f}, // рог
+	{0x0011000087c00434ull, 0.00193722069f}, // род
+	{0x0011000087c0043cull, 0.00166132802f}, // ром
+	{0x0011000087c00441ull, 0.00351613923f}, // рос
+	{0x0011000088600433ull, 0.00296017341f}, // руг
+	{0x001100008860043aull, 0.00132213521f}, // рук
+	{0x001104008600043cull, 0.00253558531f}, // сам
+	{0x001104008640043eull, 0.00351494481f}, // сво
+	{0x0011040086a00431ull, 0.00170432427f}, // себ
+	{0x0011040086a0043cull, 0.00129287387f}, // сем
+	{0x001104008700043bull, 0.00205844617f}, // сил
+	{0x0011040087400430ull, 0.00515119173f}, // ска
+	{0x0011040087400438ull, 0.00204948871f}, // ски
+	{0x001104008740043eull, 0.00331071252f}, // ско
+	{0x0011040087600435ull, 0.0020841246f}, // сле
+	{0x001104008760043eull, 0.00131138612f}, // сло
+	{0x0011040087600443ull, 0.00144754094f}, // слу
+	{0x0011040087800435ull, 0.00137826917f}, // сме
+	{0x0011040087c00431ull, 0.00156458642f}, // соб
+	{0x0011040087c00432ull, 0.00200171513f}, // сов
+	{0x0011040087e0043eull, 0.00216235383f}, // спо
+	{0x0011040087e00440ull, 0.00142843148f}, // спр
+	{0x0011040088400430ull, 0.0061813104f}, // ста
+	{0x0011040088400432ull, 0.00492665544f}, // ств
+	{0x0011040088400435ull, 0.00184704794f}, // сте
+	{0x0011040088400438ull, 0.0034791145f}, // сти
+	{0x001104008840043eull, 0.00565341208f}, // сто
+	{0x0011040088400440ull, 0.00324860681f}, // стр
+	{0x001104008840044cull, 0.00284253084f}, // сть
+	{0x0011080086000432ull, 0.00183211872f}, // тав
+	{0x001108008600043aull, 0.00438323058f}, // так
+	{0x001108008600043bull, 0.00231463229f}, // тал
+	{0x001108008600043dull, 0.00179927435f}, // тан
+	{0x0011080086000440ull, 0.00149531465f}, // тар
+	{0x0011080086400435ull, 0.00256066653f}, // тве
+	{0x001108008640043eull, 0.00268786377f}, // тво
+	{0x0011080086a0043bull, 0.00403448287f}, // тел
+	{0x0011080086a0043cull, 0.00134303619f}, // тем
+	{0x0011080086a0043full, 0.0017825535f}, // теп
+	{0x0011080086a00440ull, 0.00159683358f}, // тер
+	{0x0011080087000432ull, 0.00135079934f}, // тив
+	{0x001108008700043bull, 0.00181420357f}, // тил
+	{0x0011080087a0043eull, 0.00164102414f}, // тно
+	{0x0011080087c00431ull, 0.00249199197f}, // тоб
+	{0x0011080087c00432ull, 0.00331429555f}, // тов
+	{0x0011080087c00433ull, 0.00304497173f}, // тог
+	{0x0011080087c0043bull, 0.00353106833f}, // тол
+	{0x0011080087c0043cull, 0.00399566675f}, // том
+	{0x0011080087c0043dull, 0.00255469489f}, // тон
+	{0x0011080087c0043eull, 0.00207934715f}, // тоо
+	{0x0011080087c0043full, 0.00152756181f}, // топ
+	{0x0011080087c00440ull, 0.00594244245f}, // тор
+	{0x0011080087c00441ull, 0.00152995053f}, // тос
+	{0x0011080087c00442ull, 0.00334893144f}, // тот
+	{0x0011080087c00447ull, 0.00149531465f}, // точ
+	{0x0011080087c0044full, 0.00165177323f}, // тоя
+	{0x0011080088000430ull, 0.00225491542f}, // тра
+	{0x0011080088000435ull, 0.00228537107f}, // тре
+	{0x001108008820044full, 0.00180823193f}, // тся
+	{0x0011080089800432ull, 0.00137170032f}, // тьв
+	{0x001108008980043dull, 0.00138603244f}, // тьн
+	{0x0011080089800441ull, 0.0029667425f}, // тьс
+	{0x00110c008660043eull, 0.00129884551f}, // уго
+	{0x00110c0086800430ull, 0.00150845235f}, // уда
+	{0x00110c0086c00435ull, 0.00171746197f}, // уже
+	{0x00110c0087800430ull, 0.00166491093f}, // ума
+	{0x00110c0088200442ull, 0.00155204581f}, // уст
+	{0x0011140087c00434ull, 0.00209248508f}, // ход
+	{0x0011140087c00442ull, 0.00162728922f}, // хот
+	{0x00111c008600043bull, 0.00190019608f}, // чал
+	{0x00111c0086000441ull, 0.00203933683f}, // час
+	{0x00111c0086a0043bull, 0.00135915971f}, // чел
+	{0x00111c0086a0043cull, 0.00155443442f}, // чем
+	{0x00111c0086a0043dull, 0.00167745154f}, // чен
+	{0x00111c0086a00440ull, 0.00146485888f}, // чер
+	{0x00111c008840043eull, 0.0107651902f}, // что
+	{0x0011200086a0043dull, 0.00130422006f}, // шен
+	{0x00112c0086400430ull, 0.00236598891f}, // ыва
+	{0x00112c008760043eull, 0.00266875443f}, // ыло
+	{0x00112c0087800438ull, 0.00135318807f}, // ыми
+	{0x0011300086a00440ull, 0.00139558711f}, // ьер
+	{0x001130008740043eull, 0.00309393974f}, // ько
+	{0x0011300087a00430ull, 0.00138065789f}, // ьна
+	{0x0011300087a0043eull, 0.00241555413f}, // ьно
+	{0x001130008820044full, 0.00171387894f}, // ься
+	{0x001134008840043eull, 0.00577822048f}, // это
+	{0x00113c0087a00430ull, 0.00171328173f}, // яна
+	{0x00113c0087a00435ull, 0.00136154843f}, // яне
+	{0x00113c0087e0043eull, 0.00132452382f}, // япо
+	{0x00113c008840044cull, 0.00165774499f}, // ять
 };
 
-CTrigramFrequencyTable_Russian::CTrigramFrequencyTable_Russian()
-{
-	static const Trigram trigrams[] = {
-		{"что", 18027ull},
-		{"его", 16176ull},
-		{"ост", 14746ull},
-		{"ого", 13788ull},
-		{"ото", 12714ull},
-		{"про", 12200ull},
-		{"ени", 11491ull},
-		{"как", 11033ull},
-		{"при", 10365ull},
-		{"ста", 10351ull},
-		{"ово", 10317ull},
-		{"аза", 10286ull},
-		{"тор", 9951ull},
-		{"ест", 9912ull},
-		{"оро", 9825ull},
-		{"это", 9676ull},
-		{"был", 9630ull},
-		{"ать", 9597ull},
-		{"сто", 9467ull},
-		{"все", 9320ull},
-		{"енн", 8883ull},
-		{"она", 8682ull},
-		{"ска", 8626ull},
-		{"каз", 8299ull},
-		{"ств", 8250ull},
-		{"оль", 8242ull},
-		{"лов", 7964ull},
-		{"гов", 7943ull},
-		{"пер", 7804ull},
-		{"али", 7620ull},
-		{"под", 7581ull},
-		{"ова", 7400ull},
-		{"так", 7340ull},
-		{"ала", 7217ull},
-		{"нно", 7171ull},
-		{"оне", 7153ull},
-		{"ако", 7148ull},
-		{"вор", 7101ull},
-		{"ере", 6938ull},
-		{"тел", 6756ull},
-		{"нов", 6696ull},
-		{"том", 6691ull},
-		{"ове", 6654ull},
-		{"вал", 6642ull},
-		{"лся", 6622ull},
-		{"раз", 6569ull},
-		{"дел", 6177ull},
-		{"вер", 6163ull},
-		{"кот", 6147ull},
-		{"оло", 6141ull},
-		{"или", 6133ull},
-		{"ить", 6096ull},
-		{"ори", 6080ull},
-		{"обы", 5997ull},
-		{"жен", 5985ull},
-		{"нос", 5933ull},
-		{"тол", 5913ull},
-		{"пре", 5893ull},
-		{"рос", 5888ull},
-		{"сво", 5886ull},
-		{"льн", 5835ull},
-		{"сти", 5826ull},
-		{"ите", 5791ull},
-		{"ина", 5724ull},
-		{"пол", 5633ull},
-		{"ние", 5617ull},
-		{"тот", 5608ull},
-		{"зал", 5597ull},
-		{"аст", 5552ull},
-		{"ред", 5552ull},
-		{"тов", 5550ull},
-		{"ско", 5544ull},
-		{"ель", 5543ull},
-		{"зна", 5516ull},
-		{"ему", 5511ull},
-		{"ива", 5481ull},
-		{"стр", 5440ull},
-		{"лен", 5434ull},
-		{"ало", 5431ull},
-		{"ине", 5417ull},
-		{"опр", 5403ull},
-		{"пос", 5397ull},
-		{"ани", 5374ull},
-		{"опо", 5316ull},
-		{"мен", 5293ull},
-		{"лос", 5227ull},
-		{"ник", 5226ull},
-		{"ело", 5225ull},
-		{"ами", 5215ull},
-		{"ько", 5181ull},
-		{"тог", 5099ull},
-		{"ком", 5083ull},
-		{"епо", 5050ull},
-		{"рас", 4999ull},
-		{"ане", 4976ull},
-		{"тьс", 4968ull},
-		{"руг", 4957ull},
-		{"одн", 4953ull},
-		{"гос", 4948ull},
-		{"ипо", 4939ull},
-		{"они", 4924ull},
-		{"ког", 4890ull},
-		{"нес", 4850ull},
-		{"ели", 4843ull},
-		{"ови", 4815ull},
-		{"апо", 4762ull},
-		{"сть", 4760ull},
-		{"оди", 4758ull},
-		{"ико", 4740ull},
-		{"оже", 4721ull},
-		{"дру", 4690ull},
-		{"ела", 4684ull},
-		{"лас", 4679ull},
-		{"ног", 4660ull},
-		{"овс", 4635ull},
-		{"але", 4622ull},
-		{"гда", 4616ull},
-		{"ому", 4526ull},
-		{"ила", 4519ull},
-		{"льк", 4502ull},
-		{"тво", 4501ull},
-		{"нат", 4498ull},
-		{"ись", 4474ull},
-		{"ыло", 4469ull},
-		{"лис", 4459ull},
-		{"нас", 4447ull},
-		{"нап", 4393ull},
-		{"вид", 4381ull},
-		{"ене", 4324ull},
-		{"очт", 4307ull},
-		{"ист", 4298ull},
-		{"ния", 4296ull},
-		{"ень", 4295ull},
-		{"тве", 4288ull},
-		{"тон", 4278ull},
-		{"кон", 4271ull},
-		{"оче", 4255ull},
-		{"сам", 4246ull},
-		{"нул", 4198ull},
-		{"неп", 4182ull},
-		{"тоб", 4173ull},
-		{"епр", 4116ull},
-		{"нны", 4097ull},
-		{"ана", 4096ull},
-		{"ика", 4052ull},
-		{"ьно", 4045ull},
-		{"огд", 4017ull},
-		{"око", 4011ull},
-		{"ров", 4007ull},
-		{"ера", 3980ull},
-		{"омн", 3965ull},
-		{"ыва", 3962ull},
-		{"кол", 3940ull},
-		{"одо", 3897ull},
-		{"оон", 3882ull},
-		{"тал", 3876ull},
-		{"мне", 3874ull},
-		{"ато", 3842ull},
-		{"рил", 3833ull},
-		{"тре", 3827ull},
-		{"нем", 3821ull},
-		{"кой", 3814ull},
-		{"над", 3807ull},
-		{"аже", 3799ull},
-		{"рав", 3780ull},
-		{"лив", 3778ull},
-		{"тра", 3776ull},
-		{"лон", 3733ull},
-		{"ним", 3729ull},
-		{"ена", 3718ull},
-		{"ете", 3674ull},
-		{"ора", 3662ull},
-		{"ным", 3657ull},
-		{"ока", 3647ull},
-		{"спо", 3621ull},
-		{"ран", 3600ull},
-		{"ван", 3563ull},
-		{"ков", 3563ull},
-		{"осл", 3557ull},
-		{"оле", 3556ull},
-		{"оск", 3546ull},
-		{"нет", 3539ull},
-		{"илс", 3511ull},
-		{"ход", 3504ull},
-		{"иде", 3490ull},
-		{"сле", 3490ull},
-		{"тоо", 3482ull},
-		{"буд", 3469ull},
-		{"сил", 3447ull},
-		{"алс", 3434ull},
-		{"ски", 3432ull},
-		{"вое", 3431ull},
-		{"ной", 3421ull},
-		{"ват", 3419ull},
-		{"час", 3415ull},
-		{"ден", 3406ull},
-		{"гон", 3396ull},
-		{"ипр", 3380ull},
-		{"ата", 3377ull},
-		{"гор", 3374ull},
-		{"бра", 3364ull},
-		{"емо", 3360ull},
-		{"сов", 3352ull},
-		{"вст", 3326ull},
-		{"дет", 3325ull},
-		{"ный", 3323ull},
-		{"бол", 3322ull},
-		{"аки", 3318ull},
-		{"дно", 3315ull},
-		{"мал", 3315ull},
-		{"ает", 3310ull},
-		{"вши", 3280ull},
-		{"обр", 3263ull},
-		{"рат", 3248ull},
-		{"пок", 3245ull},
-		{"род", 3244ull},
-		{"гла", 3241ull},
-		{"апр", 3231ull},
-		{"нев", 3217ull},
-		{"едо", 3212ull},
-		{"иво", 3211ull},
-		{"анн", 3204ull},
-		{"ано", 3202ull},
-		{"ило", 3197ull},
-		{"отр", 3188ull},
-		{"чал", 3182ull},
-		{"рит", 3168ull},
-		{"кня", 3164ull},
-		{"ето", 3147ull},
-		{"гол", 3143ull},
-		{"нак", 3118ull},
-		{"пот", 3112ull},
-		{"сте", 3093ull},
-		{"еск", 3075ull},
-		{"нав", 3068ull},
-		{"тав", 3068ull},
-		{"обо", 3064ull},
-		{"пра", 3059ull},
-		{"ате", 3051ull},
-		{"нег", 3044ull},
-		{"тил", 3038ull},
-		{"нен", 3036ull},
-		{"тся", 3028ull},
-		{"ака", 3014ull},
-		{"тан", 3013ull},
-		{"осо", 3001ull},
-		{"жал", 2997ull},
-		{"теп", 2985ull},
-		{"оси", 2977ull},
-		{"епе", 2970ull},
-		{"ном", 2968ull},
-		{"иче", 2958ull},
-		{"ави", 2946ull},
-		{"нан", 2910ull},
-		{"омо", 2906ull},
-		{"ное", 2902ull},
-		{"вес", 2891ull},
-		{"етс", 2890ull},
-		{"дал", 2876ull},
-		{"уже", 2876ull},
-		{"ься", 2870ull},
-		{"яна", 2869ull},
-		{"оте", 2867ull},
-		{"себ", 2854ull},
-		{"оно", 2851ull},
-		{"адо", 2848ull},
-		{"оры", 2841ull},
-		{"нач", 2827ull},
-		{"амо", 2810ull},
-		{"отв", 2809ull},
-		{"чен", 2809ull},
-		{"лав", 2798ull},
-		{"овы", 2790ull},
-		{"ась", 2788ull},
-		{"ума", 2788ull},
-		{"ром", 2782ull},
-		{"ерь", 2776ull},
-		{"ять", 2776ull},
-		{"ось", 2773ull},
-		{"тоя", 2766ull},
-		{"ебе", 2764ull},
-		{"рем", 2764ull},
-		{"тно", 2748ull},
-		{"ита", 2738ull},
-		{"гра", 2735ull},
-		{"дав", 2735ull},
-		{"дан", 2726ull},
-		{"хот", 2725ull},
-		{"вол", 2712ull},
-		{"обе", 2701ull},
-		{"дол", 2696ull},
-		{"мог", 2694ull},
-		{"еще", 2688ull},
-		{"вен", 2686ull},
-		{"год", 2685ull},
-		{"тер", 2674ull},
-		{"нам", 2662ull},
-		{"има", 2655ull},
-		{"лан", 2650ull},
-		{"аль", 2648ull},
-		{"ода", 2639ull},
-		{"мин", 2630ull},
-		{"вой", 2621ull},
-		{"имо", 2620ull},
-		{"соб", 2620ull},
-		{"анд", 2608ull},
-		{"вот", 2605ull},
-		{"чем", 2603ull},
-		{"уст", 2599ull},
-		{"ека", 2585ull},
-		{"ноп", 2584ull},
-		{"ино", 2563ull},
-		{"тос", 2562ull},
-		{"ево", 2558ull},
-		{"рог", 2558ull},
-		{"топ", 2558ull},
-		{"мот", 2548ull},
-		{"лиц", 2541ull},
-		{"кто", 2532ull},
-		{"вов", 2529ull},
-		{"уда", 2526ull},
-		{"аяс", 2507ull},
-		{"тар", 2504ull},
-		{"точ", 2504ull},
-		{"ими", 2500ull},
-		{"ети", 2491ull},
-		{"дит", 2481ull},
-		{"вил", 2468ull},
-		{"име", 2458ull},
-		{"оми", 2454ull},
-		{"чер", 2453ull},
-		{"аме", 2448ull},
-		{"мож", 2438ull},
-		{"оде", 2436ull},
-		{"мол", 2433ull},
-		{"ида", 2429ull},
-		{"слу", 2424ull},
-		{"ину", 2422ull},
-		{"аго", 2420ull},
-		{"ара", 2420ull},
-		{"асс", 2413ull},
-		{"пом", 2409ull},
-		{"ито", 2406ull},
-		{"вос", 2394ull},
-		{"ари", 2392ull},
-		{"дор", 2392ull},
-		{"есл", 2392ull},
-		{"спр", 2392ull},
-		{"быт", 2379ull},
-		{"овн", 2378ull},
-		{"дин", 2377ull},
-		{"ерн", 2357ull},
-		{"аон", 2349ull},
-		{"вет", 2349ull},
-		{"еле", 2347ull},
-		{"вно", 2342ull},
-		{"ьер", 2337ull},
-		{"еня", 2333ull},
-		{"гоп", 2332ull},
-		{"нал", 2323ull},
-		{"авл", 2322ull},
-		{"тьн", 2321ull},
-		{"нео", 2317ull},
-		{"ожи", 2317ull},
-		{"ойс", 2317ull},
-		{"изн", 2313ull},
-		{"ьна", 2312ull},
-		{"сме", 2308ull},
-		{"ира", 2303ull},
-		{"ные", 2302ull},
-		{"рик", 2299ull},
-		{"тьв", 2297ull},
-		{"яне", 2280ull},
-		{"чел", 2276ull},
-		{"дом", 2270ull},
-		{"ыми", 2266ull},
-		{"еме", 2263ull},
-		{"тив", 2262ull},
-		{"ебя", 2258ull},
-		{"ота", 2252ull},
-		{"тем", 2249ull},
-		{"дат", 2248ull},
-		{"люб", 2248ull},
-		{"жно", 2246ull},
-		{"жет", 2245ull},
-		{"пье", 2241ull},
-		{"оза", 2236ull},
-		{"ивс", 2234ull},
-		{"воз", 2227ull},
-		{"япо", 2218ull},
-		{"рук", 2214ull},
-		{"лин", 2205ull},
-		{"няз", 2205ull},
-		{"ион", 2204ull},
-		{"дум", 2203ull},
-		{"оли", 2202ull},
-		{"еза", 2198ull},
-		{"сло", 2196ull},
-		{"йст", 2186ull},
-		{"шен", 2184ull},
-		{"нон", 2182ull},
-		{"лат", 2180ull},
-		{"уго", 2175ull},
-		{"мит", 2168ull},
-		{"сем", 2165ull},
-		{"ием", 2156ull},
-		{nullptr, 0},
-	};
-
-	_table.totalTrigramsCount = 1674564ull;
+static_assert(CTrigramFrequencyTable_Base::isSorted(trigrams), "The trigrams must be sorted for binary search");
 
-	for (quint64 i = 0; trigrams[i].trigram != nullptr; ++i)
-		_table.trigramOccurrenceTable[QString::fromUtf8(trigrams[i].trigram)] = trigrams[i].count;
+CTrigramFrequencyTable_Russian::CTrigramFrequencyTable_Russian() : CTrigramFrequencyTable_Base(trigrams)
+{
 }
@@ -7,7 +7,7 @@ greaterThan(QT_MAJOR_VERSION, 5) {
 	QT += core5compat
 }
 
-CONFIG += strict_c++
+CONFIG += strict_c++ c++17
 
 include(../../global.pri)
 
@@ -62,13 +62,38 @@ win32*:!*msvc2012:*msvc*:!*msvc2010:*msvc* {
 }
 
 HEADERS += \
+	src/ccharactertokenizer.h \
+	src/ccodecregistry.h \
+	src/cdecodingreader.h \
+	src/cencodingpreclassifier.h \
 	src/ctextparser.h \
+	src/csinglebytecodectable.h \
+	src/ctextsample.h \
+	src/ctrigramcounttable.h \
 	src/trigramfrequencytables/ctrigramfrequencytable_english.h \
+	src/trigramfrequencytables/ctrigramfrequencytable_file.h \
 	src/trigramfrequencytables/ctrigramfrequencytable_russian.h \
+	src/matchfunctions/cmatchfunction_base.h \
+	src/matchfunctions/cmatchfunction_cosine.h \
+	src/matchfunctions/cmatchfunction_l1.h \
+	src/matchfunctions/cmatchfunction_loglikelihood.h \
+	src/matchfunctions/cmatchfunction_outofplace.h \
 	src/ctextencodingdetector.h
 
 SOURCES += \
+	src/ccharactertokenizer.cpp \
+	src/ccodecregistry.cpp \
+	src/cdecodingreader.cpp \
+	src/cencodingpreclassifier.cpp \
 	src/ctextparser.cpp \
+	src/csinglebytecodectable.cpp \
+	src/ctextsample.cpp \
+	src/ctrigramcounttable.cpp \
 	src/trigramfrequencytables/ctrigramfrequencytable_english.cpp \
+	src/trigramfrequencytables/ctrigramfrequencytable_file.cpp \
 	src/trigramfrequencytables/ctrigramfrequencytable_russian.cpp \
+	src/matchfunctions/cmatchfunction_cosine.cpp \
+	src/matchfunctions/cmatchfunction_l1.cpp \
+	src/matchfunctions/cmatchfunction_loglikelihood.cpp \
+	src/matchfunctions/cmatchfunction_outofplace.cpp \
 	src/ctextencodingdetector.cpp